@@ -23,6 +23,7 @@
  */
 #include <migraphx/argument.hpp>
 #include <migraphx/functional.hpp>
+#include <migraphx/buffer_pool.hpp>
 #include <unordered_map>
 
 namespace migraphx {
@@ -30,7 +31,8 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 argument::argument(const shape& s) : m_shape(s)
 {
-    auto buffer = make_shared_array<char>(s.bytes());
+    auto* pool  = get_current_buffer_pool();
+    auto buffer = pool == nullptr ? make_shared_array<char>(s.bytes()) : pool->allocate(s.bytes());
     assign_buffer({[=]() mutable { return buffer.get(); }});
 }
 
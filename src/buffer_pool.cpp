@@ -0,0 +1,149 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/buffer_pool.hpp>
+#include <migraphx/errors.hpp>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct buffer_pool_impl
+{
+    std::size_t max_bytes = 0;
+    std::mutex m;
+    std::unordered_map<std::size_t, std::vector<std::unique_ptr<char[]>>> free_buffers; // NOLINT
+    buffer_pool::statistics stats{};
+
+    static std::size_t size_class(std::size_t n)
+    {
+        constexpr std::size_t min_class = 64;
+        if(n <= min_class)
+            return min_class;
+        // n - 1 has k bits, so n is in (2^(k-1), 2^k], which is split in four classes
+        std::size_t k = 0;
+        for(auto x = n - 1; x != 0; x >>= 1u)
+            k++;
+        std::size_t step  = std::size_t{1} << (k - 3);
+        std::size_t steps = (n - 1) / step + 1;
+        if(steps > std::numeric_limits<std::size_t>::max() / step)
+            MIGRAPHX_THROW("buffer_pool: allocation of " + std::to_string(n) +
+                           " bytes is too large");
+        return steps * step;
+    }
+
+    void release(char* p, std::size_t n)
+    {
+        std::unique_ptr<char[]> buffer{p}; // NOLINT
+        std::lock_guard<std::mutex> lock{m};
+        if(stats.bytes_held + n > max_bytes)
+            return;
+        free_buffers[n].push_back(std::move(buffer));
+        stats.bytes_held += n;
+    }
+
+    void trim(std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock{m};
+        for(auto it = free_buffers.begin(); it != free_buffers.end() and stats.bytes_held > n;)
+        {
+            auto& buffers = it->second;
+            while(not buffers.empty() and stats.bytes_held > n)
+            {
+                buffers.pop_back();
+                stats.bytes_held -= it->first;
+            }
+            if(buffers.empty())
+                it = free_buffers.erase(it);
+            else
+                ++it;
+        }
+    }
+};
+
+buffer_pool::buffer_pool(std::size_t max_bytes) : impl(std::make_shared<buffer_pool_impl>())
+{
+    impl->max_bytes = max_bytes;
+}
+
+std::shared_ptr<char> buffer_pool::allocate(std::size_t n) const
+{
+    auto cls = buffer_pool_impl::size_class(n);
+    std::unique_ptr<char[]> buffer; // NOLINT
+    {
+        std::lock_guard<std::mutex> lock{impl->m};
+        auto it = impl->free_buffers.find(cls);
+        if(it != impl->free_buffers.end() and not it->second.empty())
+        {
+            buffer = std::move(it->second.back());
+            it->second.pop_back();
+            impl->stats.bytes_held -= cls;
+            impl->stats.hits++;
+        }
+        else
+        {
+            impl->stats.misses++;
+        }
+    }
+    if(buffer == nullptr)
+        buffer.reset(new char[cls]()); // NOLINT
+    else
+        std::memset(buffer.get(), 0, n);
+    std::weak_ptr<buffer_pool_impl> pool = impl;
+    return {buffer.release(), [pool, cls](char* p) {
+                if(auto self = pool.lock())
+                    self->release(p, cls);
+                else
+                    delete[] p; // NOLINT
+            }};
+}
+
+buffer_pool::statistics buffer_pool::get_statistics() const
+{
+    std::lock_guard<std::mutex> lock{impl->m};
+    return impl->stats;
+}
+
+void buffer_pool::trim(std::size_t max_bytes) const { impl->trim(max_bytes); }
+
+static buffer_pool*& current_buffer_pool()
+{
+    static thread_local buffer_pool* pool = nullptr; // NOLINT
+    return pool;
+}
+
+buffer_pool* get_current_buffer_pool() { return current_buffer_pool(); }
+
+buffer_pool_scope::buffer_pool_scope(buffer_pool* p) : prev(current_buffer_pool())
+{
+    current_buffer_pool() = p;
+}
+
+buffer_pool_scope::~buffer_pool_scope() { current_buffer_pool() = prev; }
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
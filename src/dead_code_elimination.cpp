@@ -62,7 +62,9 @@ void dead_code_elimination::apply(module& m) const
             if(not m.has_instruction(leaf))
                 return;
 
-            if(leaf->outputs().empty())
+            // Writes to a state are kept even when their result is not used
+            if(leaf->outputs().empty() and
+               not leaf->get_operator().attributes().get("side_effects", false))
             {
                 // Dont visit inputs twice
                 if(not visited.insert(leaf).second)
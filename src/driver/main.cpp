@@ -40,7 +40,9 @@
 #include <migraphx/stringutils.hpp>
 #include <migraphx/convert_to_json.hpp>
 #include <migraphx/load_save.hpp>
+#include <migraphx/file_buffer.hpp>
 #include <migraphx/json.hpp>
+#include <migraphx/time.hpp>
 #include <migraphx/version.h>
 
 #include <migraphx/dead_code_elimination.hpp>
@@ -54,8 +56,12 @@
 #include <migraphx/simplify_algebra.hpp>
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/select_module_statistics.hpp>
 
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
+#include <numeric>
 
 namespace migraphx {
 namespace driver {
@@ -76,9 +82,11 @@ struct loader
     bool is_nhwc                = true;
     bool is_test                = false;
     unsigned trim               = 0;
+    std::size_t model_size      = 1;
     bool optimize               = false;
     bool skip_unknown_operators = false;
     bool brief                  = false;
+    std::string model;
     std::string output_type;
     std::string output;
     std::string default_dyn_dim;
@@ -96,6 +104,11 @@ struct loader
            ap.help("Run a single GEMM to test MIGraphX"),
            ap.set_value(true),
            ap.group("input"));
+        ap(model,
+           {"--model"},
+           ap.help("Load a built-in benchmark model (" + to_string_range(get_model_names()) + ")"),
+           ap.group("input"));
+        ap(model_size, {"--model-size"}, ap.help("Size of the built-in benchmark model"));
         ap(file_type, {"--onnx"}, ap.help("Load as onnx"), ap.set_value("onnx"));
         ap(file_type, {"--tf"}, ap.help("Load as tensorflow"), ap.set_value("tf"));
         ap(file_type, {"--migraphx"}, ap.help("Load as MIGraphX"), ap.set_value("migraphx"));
@@ -315,6 +328,10 @@ struct loader
         {
             p = test_gemm();
         }
+        else if(not model.empty())
+        {
+            p = load_model(model, model_size);
+        }
         else
         {
             if(file_type.empty())
@@ -499,6 +516,22 @@ struct compiler
            {"--exhaustive-tune"},
            ap.help("Exhastively search for best tuning parameters for kernels"),
            ap.set_value(true));
+        ap(co.specialize_cache_size,
+           {"--specialize-shapes"},
+           ap.help("Compile dynamic programs for the input shapes they are run with, keeping up "
+                   "to this many of them"));
+        ap(co.precompile_optimals,
+           {"--precompile-optimals"},
+           ap.help("Compile the shapes of the optimals in the background with "
+                   "--specialize-shapes"),
+           ap.set_value(true));
+        ap(co.bucket_dynamic_shapes,
+           {"--bucket-dynamic-shapes"},
+           ap.help("Only compile the optimals of a dynamic dimension and pad inputs up to them"),
+           ap.set_value(true));
+        ap(co.bucket_pad_value,
+           {"--bucket-pad-value"},
+           ap.help("Value to pad the inputs with for --bucket-dynamic-shapes"));
         ap(to_fp16, {"--fp16"}, ap.help("Quantize for fp16"), ap.set_value(true));
         ap(to_int8, {"--int8"}, ap.help("Quantize for int8"), ap.set_value(true));
         ap(to_fp8, {"--fp8"}, ap.help("Quantize for fp8e4m3fnuz type"), ap.set_value(true));
@@ -682,8 +715,11 @@ struct run_cmd : command<run_cmd>
 struct perf : command<perf>
 {
     compiler c;
-    unsigned n    = 100;
-    bool detailed = false;
+    unsigned n       = 100;
+    bool detailed    = false;
+    double threshold = 5;
+    std::string save_baseline;
+    std::string compare;
     void parse(argument_parser& ap)
     {
         c.parse(ap);
@@ -692,6 +728,15 @@ struct perf : command<perf>
            {"--detailed", "-d"},
            ap.help("Show a more detailed summary report"),
            ap.set_value(true));
+        ap(save_baseline,
+           {"--save-baseline"},
+           ap.help("Save the timing samples to a json file to compare against later"));
+        ap(compare,
+           {"--compare"},
+           ap.help("Compare the timings against a baseline saved with --save-baseline"));
+        ap(threshold,
+           {"--threshold"},
+           ap.help("Percent slowdown compared to the baseline that is reported as a failure"));
     }
 
     void run()
@@ -700,8 +745,111 @@ struct perf : command<perf>
         auto p = c.compile();
         std::cout << "Allocating params ... " << std::endl;
         auto m = c.params(p);
-        std::cout << "Running performance report ... " << std::endl;
-        p.perf_report(std::cout, n, m, c.l.batch, detailed);
+        if(save_baseline.empty() and compare.empty())
+        {
+            std::cout << "Running performance report ... " << std::endl;
+            p.perf_report(std::cout, n, m, c.l.batch, detailed);
+            auto stats = get_select_module_statistics(p);
+            if(not stats.hits.empty())
+            {
+                std::cout << "select_module runs: " << stats.exact << " exact, " << stats.padded
+                          << " padded" << std::endl;
+                for(const auto& [name, hits] : stats.hits)
+                    std::cout << "    " << name << ": " << hits << std::endl;
+            }
+            return;
+        }
+        std::cout << "Collecting timing samples ... " << std::endl;
+        auto samples = collect_perf_samples(p, n, m);
+        if(not save_baseline.empty())
+        {
+            std::ofstream fs(save_baseline);
+            fs << to_pretty_json_string(samples) << std::endl;
+        }
+        if(not compare.empty())
+        {
+            auto baseline = from_json_string(read_string(compare));
+            if(not compare_perf_samples(std::cout, baseline, samples, threshold))
+                std::exit(EXIT_FAILURE);
+        }
+    }
+};
+
+struct bench : command<bench>
+{
+    using milliseconds = std::chrono::duration<double, std::milli>;
+    compiler_target ct;
+    compile_options co;
+    std::vector<std::string> models;
+    std::size_t size = 1;
+    unsigned batch   = 1;
+    unsigned n       = 100;
+    std::string output;
+
+    void parse(argument_parser& ap)
+    {
+        ct.parse(ap);
+        ap(models,
+           {"--model", "-m"},
+           ap.help("Built-in models to benchmark, all models are run by default (" +
+                   to_string_range(get_model_names()) + ")"),
+           ap.append());
+        ap(size, {"--model-size"}, ap.help("Size of the built-in benchmark models"));
+        ap(batch, {"--batch"}, ap.help("Batch size used to run models with a dynamic batch"));
+        ap(n, {"--iterations", "-n"}, ap.help("Number of iterations to run for each model"));
+        ap(output, {"--output", "-o"}, ap.help("Write the JSON results to a file"));
+    }
+
+    value run_model(const std::string& name) const
+    {
+        std::cout << "Benchmarking " << name << " ... " << std::endl;
+        auto p            = load_model(name, size);
+        auto t            = ct.get_target();
+        auto compile_time = time<milliseconds>([&] { p.compile(t, co); });
+        auto m            = program_params{}.generate(p, t, co.offload_copy, batch);
+        // Warmup
+        p.eval(m);
+        p.finish();
+        std::vector<double> times;
+        std::generate_n(std::back_inserter(times), std::max(n, 1u), [&] {
+            return time<milliseconds>([&] {
+                p.eval(m);
+                p.finish();
+            });
+        });
+        std::sort(times.begin(), times.end());
+        auto total = std::accumulate(times.begin(), times.end(), 0.0);
+        return {{"model", name},
+                {"compile_ms", compile_time},
+                {"mean_ms", total / times.size()},
+                {"median_ms", times[times.size() / 2]},
+                {"min_ms", times.front()},
+                {"max_ms", times.back()}};
+    }
+
+    void run()
+    {
+        if(models.empty())
+            models = get_model_names();
+        value results = value::array{};
+        transform(models, std::back_inserter(results), [&](const auto& name) {
+            return run_model(name);
+        });
+        value report = {{"target", ct.target_name},
+                        {"model_size", size},
+                        {"batch", batch},
+                        {"iterations", n},
+                        {"results", results}};
+        auto json = to_pretty_json_string(report);
+        if(output.empty())
+        {
+            std::cout << json << std::endl;
+        }
+        else
+        {
+            std::ofstream fs(output);
+            fs << json << std::endl;
+        }
     }
 };
 
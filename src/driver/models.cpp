@@ -25,6 +25,14 @@
 #include "models.hpp"
 #include <migraphx/program.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/common.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
 
 namespace migraphx {
 namespace driver {
@@ -40,6 +48,267 @@ migraphx::program test_gemm()
     return p;
 }
 
+namespace {
+
+// Weights are deterministic so the same model is generated on every run
+struct weight_generator
+{
+    unsigned long seed = 0;
+    instruction_ref operator()(module& m, const std::vector<std::size_t>& lens)
+    {
+        return m.add_literal(generate_literal({shape::float_type, lens}, seed++));
+    }
+};
+
+// Fully connected layer over the last dimension of x
+instruction_ref linear(module& m, weight_generator& w, instruction_ref x, std::size_t n)
+{
+    auto k      = x->get_shape().max_lens().back();
+    auto weight = w(m, {k, n});
+    if(x->get_shape().ndim() > 2)
+    {
+        auto lens = x->get_shape().lens();
+        lens.erase(lens.end() - 2, lens.end());
+        lens.insert(lens.end(), {k, n});
+        weight = m.add_instruction(make_op("multibroadcast", {{"out_lens", lens}}), weight);
+    }
+    auto y = m.add_instruction(make_op("dot"), x, weight);
+    return add_common_op(m, make_op("add"), {y, w(m, {n})});
+}
+
+instruction_ref conv(module& m,
+                     weight_generator& w,
+                     instruction_ref x,
+                     std::size_t channels,
+                     std::size_t kernel,
+                     std::size_t stride = 1)
+{
+    auto in_channels = x->get_shape().lens()[1];
+    auto pad         = kernel / 2;
+    return m.add_instruction(
+        make_op("convolution", {{"padding", {pad, pad}}, {"stride", {stride, stride}}}),
+        x,
+        w(m, {channels, in_channels, kernel, kernel}));
+}
+
+instruction_ref layernorm(module& m, weight_generator& w, instruction_ref x)
+{
+    auto axis = x->get_shape().ndim() - 1;
+    auto n    = x->get_shape().lens().back();
+    auto mean = m.add_instruction(make_op("reduce_mean", {{"axes", {axis}}}), x);
+    auto diff = add_common_op(m, make_op("sub"), {x, mean});
+    auto sq   = m.add_instruction(make_op("mul"), diff, diff);
+    auto var  = m.add_instruction(make_op("reduce_mean", {{"axes", {axis}}}), sq);
+    auto eps  = m.add_literal(literal{shape{shape::float_type, {1}}, {1e-5f}});
+    auto rstd = m.add_instruction(make_op("rsqrt"), add_common_op(m, make_op("add"), {var, eps}));
+    auto y    = add_common_op(m, make_op("mul"), {diff, rstd});
+    y         = add_common_op(m, make_op("mul"), {y, w(m, {n})});
+    return add_common_op(m, make_op("add"), {y, w(m, {n})});
+}
+
+} // namespace
+
+migraphx::program resnet(std::size_t size)
+{
+    const std::size_t batch   = 1;
+    const std::size_t classes = 100;
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    weight_generator w;
+    auto x = mm->add_parameter("x", shape{shape::float_type, {batch, 3, 64, 64}});
+
+    std::size_t channels = 16 * size;
+
+    x = mm->add_instruction(make_op("relu"), conv(*mm, w, x, channels, 3, 2));
+    for(std::size_t stage = 0; stage < 3; stage++)
+    {
+        if(stage > 0)
+        {
+            channels *= 2;
+            x = mm->add_instruction(make_op("relu"), conv(*mm, w, x, channels, 3, 2));
+        }
+        for(std::size_t block = 0; block < 2; block++)
+        {
+            auto y = mm->add_instruction(make_op("relu"), conv(*mm, w, x, channels, 3));
+            y      = conv(*mm, w, y, channels, 3);
+            y      = mm->add_instruction(make_op("add"), x, y);
+            x      = mm->add_instruction(make_op("relu"), y);
+        }
+    }
+    x = mm->add_instruction(make_op("reduce_mean", {{"axes", {2, 3}}}), x);
+    x = mm->add_instruction(make_op("squeeze", {{"axes", {2, 3}}}), x);
+    x = linear(*mm, w, x, classes);
+    mm->add_instruction(make_op("softmax", {{"axis", 1}}), x);
+    return p;
+}
+
+migraphx::program bert(std::size_t size)
+{
+    const std::size_t batch  = 1;
+    const std::size_t seq    = 64;
+    const std::size_t heads  = 4;
+    const std::size_t layers = 2;
+    const std::size_t hidden = 64 * size;
+    const std::size_t dim    = hidden / heads;
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    weight_generator w;
+    auto x = mm->add_parameter("x", shape{shape::float_type, {batch, seq, hidden}});
+
+    auto split_heads = [&](instruction_ref y, std::vector<int64_t> perm) {
+        y = mm->add_instruction(make_op("reshape", {{"dims", {batch, seq, heads, dim}}}), y);
+        return mm->add_instruction(make_op("transpose", {{"permutation", perm}}), y);
+    };
+    auto scale = mm->add_literal(
+        literal{shape{shape::float_type, {1}}, {1.0f / std::sqrt(static_cast<float>(dim))}});
+    for(std::size_t layer = 0; layer < layers; layer++)
+    {
+        auto q = split_heads(linear(*mm, w, x, hidden), {0, 2, 1, 3});
+        auto k = split_heads(linear(*mm, w, x, hidden), {0, 2, 3, 1});
+        auto v = split_heads(linear(*mm, w, x, hidden), {0, 2, 1, 3});
+        auto s = mm->add_instruction(make_op("dot"), q, k);
+        s      = add_common_op(*mm, make_op("mul"), {s, scale});
+        s      = mm->add_instruction(make_op("softmax", {{"axis", 3}}), s);
+        auto a = mm->add_instruction(make_op("dot"), s, v);
+        a      = mm->add_instruction(make_op("transpose", {{"permutation", {0, 2, 1, 3}}}), a);
+        a      = mm->add_instruction(make_op("contiguous"), a);
+        a      = mm->add_instruction(make_op("reshape", {{"dims", {batch, seq, hidden}}}), a);
+        a      = linear(*mm, w, a, hidden);
+        x      = layernorm(*mm, w, mm->add_instruction(make_op("add"), x, a));
+
+        auto f = linear(*mm, w, x, 4 * hidden);
+        f      = mm->add_instruction(make_op("relu"), f);
+        f      = linear(*mm, w, f, hidden);
+        x      = layernorm(*mm, w, mm->add_instruction(make_op("add"), x, f));
+    }
+    return p;
+}
+
+migraphx::program lstm_seq2seq(std::size_t size)
+{
+    const std::size_t batch  = 4;
+    const std::size_t seq    = 16;
+    const std::size_t input  = 32;
+    const std::size_t vocab  = 256;
+    const std::size_t hidden = 64 * size;
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    weight_generator w;
+    auto src = mm->add_parameter("src", shape{shape::float_type, {seq, batch, input}});
+    auto tgt = mm->add_parameter("tgt", shape{shape::float_type, {seq, batch, input}});
+
+    auto lstm = make_op("lstm", {{"hidden_size", hidden}});
+    auto enc  = mm->add_instruction(lstm,
+                                   src,
+                                   w(*mm, {1, 4 * hidden, input}),
+                                   w(*mm, {1, 4 * hidden, hidden}),
+                                   w(*mm, {1, 8 * hidden}));
+    auto h    = mm->add_instruction(make_op("rnn_last_hs_output"), enc);
+    auto c    = mm->add_instruction(make_op("rnn_last_cell_output"), enc);
+    auto und  = mm->add_instruction(make_op("undefined"));
+    auto dec  = mm->add_instruction(lstm,
+                                   {tgt,
+                                    w(*mm, {1, 4 * hidden, input}),
+                                    w(*mm, {1, 4 * hidden, hidden}),
+                                    w(*mm, {1, 8 * hidden}),
+                                    und,
+                                    h,
+                                    c});
+    auto y    = mm->add_instruction(make_op("squeeze", {{"axes", {1}}}), dec);
+    y         = linear(*mm, w, y, vocab);
+    mm->add_instruction(make_op("softmax", {{"axis", 2}}), y);
+    return p;
+}
+
+migraphx::program detection_head(std::size_t size)
+{
+    const std::size_t classes  = 4;
+    const std::size_t channels = 32;
+    const std::size_t boxes    = 256 * size;
+    const std::size_t rois     = 32 * size;
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    weight_generator w;
+    auto features = mm->add_parameter("features", shape{shape::float_type, {1, channels, 28, 28}});
+    auto box      = mm->add_parameter("boxes", shape{shape::float_type, {1, boxes, 4}});
+    auto score    = mm->add_parameter("scores", shape{shape::float_type, {1, classes, boxes}});
+    auto roi      = mm->add_parameter("rois", shape{shape::float_type, {rois, 4}});
+
+    auto max_out = mm->add_literal(int64_t{16});
+    auto iou     = mm->add_literal(0.5f);
+    auto thresh  = mm->add_literal(0.0f);
+    auto nms     = mm->add_instruction(make_op("nonmaxsuppression", {{"center_point_box", true}}),
+                                   box,
+                                   score,
+                                   max_out,
+                                   iou,
+                                   thresh);
+
+    auto indices = mm->add_literal(
+        literal{shape{shape::int64_type, {rois}}, std::vector<int64_t>(rois, 0)});
+    auto pooled = mm->add_instruction(make_op("roialign",
+                                              {{"output_height", 7},
+                                               {"output_width", 7},
+                                               {"sampling_ratio", 2},
+                                               {"spatial_scale", 28.0f}}),
+                                      features,
+                                      roi,
+                                      indices);
+    auto y = mm->add_instruction(make_op("flatten", {{"axis", 1}}), pooled);
+    y      = mm->add_instruction(make_op("relu"), linear(*mm, w, y, 128));
+    y      = linear(*mm, w, y, classes);
+    y      = mm->add_instruction(make_op("softmax", {{"axis", 1}}), y);
+    mm->add_return({nms, y});
+    return p;
+}
+
+migraphx::program dynamic_mlp(std::size_t size)
+{
+    const std::size_t input   = 128;
+    const std::size_t classes = 10;
+    const std::size_t hidden  = 256 * size;
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    weight_generator w;
+    auto x =
+        mm->add_parameter("x", shape{shape::float_type, {{1, 64, {1, 8, 32}}, {input, input}}});
+    x      = mm->add_instruction(make_op("relu"), linear(*mm, w, x, hidden));
+    x      = mm->add_instruction(make_op("relu"), linear(*mm, w, x, hidden));
+    x      = linear(*mm, w, x, classes);
+    mm->add_instruction(make_op("softmax", {{"axis", 1}}), x);
+    return p;
+}
+
+static const std::unordered_map<std::string, std::function<program(std::size_t)>>& model_map()
+{
+    static const std::unordered_map<std::string, std::function<program(std::size_t)>> m = {
+        {"resnet", &resnet},
+        {"bert", &bert},
+        {"lstm", &lstm_seq2seq},
+        {"detection", &detection_head},
+        {"mlp", &dynamic_mlp},
+    };
+    return m;
+}
+
+std::vector<std::string> get_model_names()
+{
+    std::vector<std::string> result;
+    transform(model_map(), std::back_inserter(result), [](auto&& p) { return p.first; });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+migraphx::program load_model(const std::string& name, std::size_t size)
+{
+    auto it = model_map().find(name);
+    if(it == model_map().end())
+        MIGRAPHX_THROW("Unknown model: " + name);
+    if(size == 0)
+        MIGRAPHX_THROW("Model size must be greater than 0");
+    return it->second(size);
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
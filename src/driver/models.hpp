@@ -23,6 +23,8 @@
  */
 
 #include <migraphx/program.hpp>
+#include <string>
+#include <vector>
 
 namespace migraphx {
 namespace driver {
@@ -30,6 +32,22 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 migraphx::program test_gemm();
 
+/// ResNet-style CNN, the size scales the number of channels
+migraphx::program resnet(std::size_t size = 1);
+/// BERT-style encoder with multi-head attention, the size scales the hidden dimension
+migraphx::program bert(std::size_t size = 1);
+/// LSTM encoder/decoder, the size scales the hidden dimension
+migraphx::program lstm_seq2seq(std::size_t size = 1);
+/// Detection head with non-max suppression and ROI align, the size scales the number of boxes
+migraphx::program detection_head(std::size_t size = 1);
+/// MLP with a dynamic batch dimension, the size scales the hidden dimension
+migraphx::program dynamic_mlp(std::size_t size = 1);
+
+/// Names of the built-in benchmark models
+std::vector<std::string> get_model_names();
+/// Create one of the built-in benchmark models by name
+migraphx::program load_model(const std::string& name, std::size_t size = 1);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
@@ -27,9 +27,18 @@
 #include <migraphx/instruction.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/functional.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/specialize_shapes.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/time.hpp>
 #ifdef HAVE_GPU
 #include <migraphx/gpu/hip.hpp>
 #endif
+#include <chrono>
+#include <cmath>
+#include <numeric>
 
 namespace migraphx {
 namespace driver {
@@ -131,6 +140,196 @@ bool is_offload_copy_set(const program& p)
     return param_ins.empty();
 }
 
+using milliseconds = std::chrono::duration<double, std::milli>;
+
+static std::string perf_key(const module& m, instruction_ref ins)
+{
+    std::vector<shape> inputs;
+    std::transform(ins->inputs().begin(),
+                   ins->inputs().end(),
+                   std::back_inserter(inputs),
+                   [](auto i) { return i->get_shape(); });
+    return m.name() + ":" + ins->name() + "(" + to_string_range(inputs, ", ") + ") -> " +
+           to_string(ins->get_shape());
+}
+
+value collect_perf_samples(const program& p, std::size_t n, const parameter_map& m)
+{
+    // The instructions that run are the ones of the program specialized to the input shapes
+    if(auto cache = p.get_specialization_cache())
+        return collect_perf_samples(*cache->get(m), n, m);
+    // Run once by itself
+    p.eval(m);
+    p.finish();
+    std::vector<double> total;
+    std::generate_n(std::back_inserter(total), n, [&] {
+        return time<milliseconds>([&] {
+            p.eval(m);
+            p.finish();
+        });
+    });
+    auto ins_samples = p.time_instructions(n, m);
+
+    value instructions = value::array{};
+    for(const auto* mod : p.get_modules())
+    {
+        std::unordered_map<std::string, std::size_t> positions;
+        for(auto ins : iterator_for(*mod))
+        {
+            if(ins->name() == "@return" or not contains(ins_samples, ins))
+                continue;
+            auto key = perf_key(*mod, ins);
+            instructions.push_back({{"id", key + "#" + std::to_string(positions[key]++)},
+                                    {"op", ins->name()},
+                                    {"samples", ins_samples.at(ins)}});
+        }
+    }
+    return {{"iterations", n}, {"total", total}, {"instructions", instructions}};
+}
+
+namespace {
+
+struct sample_stats
+{
+    double mean     = 0;
+    double variance = 0;
+    std::size_t n   = 0;
+
+    // Outliers are trimmed the same way as the perf report
+    explicit sample_stats(std::vector<double> v)
+    {
+        std::sort(v.begin(), v.end());
+        auto trim = v.size() / 4;
+        auto x    = range(v.begin() + trim, v.end() - trim);
+        n         = x.end() - x.begin();
+        if(n == 0)
+            return;
+        mean = std::accumulate(x.begin(), x.end(), 0.0) / n;
+        if(n < 2)
+            return;
+        for(auto y : x)
+            variance += (y - mean) * (y - mean);
+        variance /= (n - 1);
+    }
+};
+
+struct perf_delta
+{
+    std::string name;
+    double baseline  = 0;
+    double current   = 0;
+    double percent   = 0;
+    bool significant = false;
+
+    perf_delta(std::string pname, const std::vector<double>& x, const std::vector<double>& y)
+        : name(std::move(pname))
+    {
+        sample_stats a{x};
+        sample_stats b{y};
+        baseline = a.mean;
+        current  = b.mean;
+        if(baseline > 0)
+            percent = 100.0 * (current - baseline) / baseline;
+        // Welch's t-test, using the normal approximation for a 95% confidence
+        auto se = std::sqrt((a.n > 0 ? a.variance / a.n : 0) + (b.n > 0 ? b.variance / b.n : 0));
+        if(se > 0)
+            significant = std::abs(current - baseline) / se > 1.96;
+        else
+            significant = current != baseline;
+    }
+
+    bool regressed(double threshold) const { return significant and percent > threshold; }
+};
+
+std::ostream& operator<<(std::ostream& os, const perf_delta& d)
+{
+    os << d.name << ": " << d.baseline << "ms -> " << d.current << "ms, " << std::showpos
+       << d.percent << std::noshowpos << "%";
+    if(d.significant)
+        os << " *";
+    return os;
+}
+
+std::vector<double> get_samples(const value& v) { return v.to_vector<double>(); }
+
+// Sum the samples from each run of every instruction of the same operator
+std::unordered_map<std::string, std::vector<double>> op_samples(const value& instructions)
+{
+    std::unordered_map<std::string, std::vector<double>> result;
+    for(const auto& ins : instructions)
+    {
+        auto samples = get_samples(ins.at("samples"));
+        auto& op     = result[ins.at("op").to<std::string>()];
+        op.resize(std::max(op.size(), samples.size()));
+        std::transform(samples.begin(), samples.end(), op.begin(), op.begin(), std::plus<>{});
+    }
+    return result;
+}
+
+} // namespace
+
+bool compare_perf_samples(std::ostream& os,
+                          const value& baseline,
+                          const value& current,
+                          double threshold)
+{
+    bool passed = true;
+
+    std::unordered_map<std::string, const value*> baseline_ins;
+    for(const auto& ins : baseline.at("instructions"))
+        baseline_ins[ins.at("id").to<std::string>()] = &ins;
+    std::vector<perf_delta> ins_deltas;
+    std::size_t unmatched = 0;
+    for(const auto& ins : current.at("instructions"))
+    {
+        auto id = ins.at("id").to<std::string>();
+        if(not contains(baseline_ins, id))
+        {
+            unmatched++;
+            continue;
+        }
+        perf_delta d{
+            id, get_samples(baseline_ins.at(id)->at("samples")), get_samples(ins.at("samples"))};
+        if(d.significant)
+            ins_deltas.push_back(d);
+    }
+    std::sort(ins_deltas.begin(), ins_deltas.end(), by(std::greater<>{}, [](const auto& d) {
+                  return std::abs(d.current - d.baseline);
+              }));
+    os << "Instructions:" << std::endl;
+    for(const auto& d : ins_deltas)
+        os << d << std::endl;
+    if(unmatched > 0)
+        os << unmatched << " instructions not found in the baseline" << std::endl;
+    os << std::endl;
+
+    auto baseline_ops = op_samples(baseline.at("instructions"));
+    auto current_ops  = op_samples(current.at("instructions"));
+    std::vector<perf_delta> op_deltas;
+    for(const auto& [op, samples] : current_ops)
+    {
+        if(contains(baseline_ops, op))
+            op_deltas.emplace_back(op, baseline_ops.at(op), samples);
+    }
+    std::sort(op_deltas.begin(), op_deltas.end(), by(std::greater<>{}, [](const auto& d) {
+                  return d.current;
+              }));
+    os << "Operators:" << std::endl;
+    for(const auto& d : op_deltas)
+    {
+        os << d << std::endl;
+        passed = passed and not d.regressed(threshold);
+    }
+    os << std::endl;
+
+    perf_delta total{"Total", get_samples(baseline.at("total")), get_samples(current.at("total"))};
+    os << total << std::endl;
+    passed = passed and not total.regressed(threshold);
+    if(not passed)
+        os << "Performance regressed by more than " << threshold << "%" << std::endl;
+    return passed;
+}
+
 } // namespace  MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
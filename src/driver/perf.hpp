@@ -25,6 +25,8 @@
 #define MIGRAPHX_GUARD_RTGLIB_PERF_HPP
 
 #include <migraphx/program.hpp>
+#include <migraphx/value.hpp>
+#include <ostream>
 
 namespace migraphx {
 namespace driver {
@@ -49,6 +51,24 @@ target get_target(bool gpu);
  */
 bool is_offload_copy_set(const program& p);
 
+/**
+ * @brief Collects timing samples, in milliseconds, for the whole program and for each
+ * instruction. Instructions are keyed by their module, operator, shapes and the position among
+ * instructions with the same key so they can be matched against samples from another build.
+ */
+value collect_perf_samples(const program& p, std::size_t n, const parameter_map& m);
+
+/**
+ * @brief Compares samples from collect_perf_samples against a baseline and prints the per
+ * operator and total deltas.
+ * @return false if the total or an operator is significantly slower than the baseline by more
+ * than threshold percent
+ */
+bool compare_perf_samples(std::ostream& os,
+                          const value& baseline,
+                          const value& current,
+                          double threshold);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
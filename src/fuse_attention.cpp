@@ -0,0 +1,122 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/fuse_attention.hpp>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/match/attention.hpp>
+#include <migraphx/matcher.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The value of a constant that has the same value everywhere
+static std::optional<double> get_uniform_value(instruction_ref ins)
+{
+    auto arg = ins->eval();
+    if(arg.empty())
+        return std::nullopt;
+    std::optional<double> result;
+    arg.visit([&](auto x) {
+        if(std::all_of(x.begin(), x.end(), [&](auto y) { return float_equal(y, x.front()); }))
+            result = x.front();
+    });
+    return result;
+}
+
+// Whether the mask is 0 where query i attends to key j <= i + n - m, and negative infinity
+// (or the lowest value) everywhere else
+static bool is_causal_mask(instruction_ref mask)
+{
+    auto arg = mask->eval();
+    if(arg.empty())
+        return false;
+    const auto& s = arg.get_shape();
+    auto ndim     = s.ndim();
+    auto m        = static_cast<std::ptrdiff_t>(s.lens()[ndim - 2]);
+    auto n        = static_cast<std::ptrdiff_t>(s.lens()[ndim - 1]);
+    bool result   = true;
+    arg.visit([&](auto x) {
+        using type = typename decltype(x)::value_type;
+        shape_for_each(s, [&](const auto& idx) {
+            if(not result)
+                return;
+            auto i = static_cast<std::ptrdiff_t>(idx[ndim - 2]);
+            auto j = static_cast<std::ptrdiff_t>(idx[ndim - 1]);
+            auto y = x(idx.begin(), idx.end());
+            if(j <= i + n - m)
+                result = float_equal(y, 0);
+            else
+                result = float_equal(y, std::numeric_limits<type>::lowest()) or
+                         (std::isinf(static_cast<double>(y)) and y < 0);
+        });
+    });
+    return result;
+}
+
+struct find_attention
+{
+    auto matcher() const { return match::attention(); }
+
+    void apply(module& m, const match::matcher_result& r) const
+    {
+        auto ins     = r.result;
+        auto q       = r.instructions["q"];
+        auto kt      = r.instructions["kt"];
+        auto v       = r.instructions["v"];
+        double scale = 1.0;
+        if(contains(r.instructions, "scale") or contains(r.instructions, "inv_scale"))
+        {
+            bool inverse = contains(r.instructions, "inv_scale");
+            auto value   = get_uniform_value(r.instructions[inverse ? "inv_scale" : "scale"]);
+            if(not value.has_value() or (inverse and float_equal(*value, 0)))
+                return;
+            scale = inverse ? 1.0 / *value : *value;
+        }
+        std::vector<instruction_ref> inputs = {q, kt};
+        bool causal                         = false;
+        if(contains(r.instructions, "mask"))
+        {
+            auto mask = r.instructions["mask"];
+            causal    = is_causal_mask(mask);
+            if(not causal)
+                inputs.push_back(mask);
+        }
+        inputs.push_back(v);
+        m.replace_instruction(
+            ins, make_op("attention", {{"scale", scale}, {"causal", causal}}), inputs);
+    }
+};
+
+void fuse_attention::apply(module& m) const { match::find_matches(m, find_attention{}); }
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
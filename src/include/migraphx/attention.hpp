@@ -0,0 +1,145 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_ATTENTION_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_ATTENTION_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/softmax.hpp>
+#include <migraphx/tensor_view.hpp>
+#include <migraphx/type_traits.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Scaled dot product attention, softmax(scale * q * kt + mask) * v, where the softmax is over
+ * the last axis and mask is optional (an empty tensor_view). With causal, query i only attends
+ * to the keys up to i + n - m, where m is the number of queries and n the number of keys.
+ *
+ * This is computed flash attention style, so the [m, n] scores are never materialized: the
+ * queries are split in blocks, and each block goes through the keys a block at a time with
+ * online softmax. The output rows are accumulated relative to the running maximum and rescaled
+ * when it changes. Every query block only needs extra memory for its output rows and the scores
+ * of one key block, and the blocks of every batch are computed in parallel.
+ */
+template <class Output, class Query, class Key, class Value, class Mask>
+void attention(Output output, Query q, Key kt, Value v, Mask mask, double scale, bool causal)
+{
+    using value_type                  = accumulator_type<typename Output::value_type>;
+    constexpr std::size_t query_block = 16;
+    constexpr std::size_t key_block   = 64;
+    const auto& out_s                 = output.get_shape();
+    const auto& q_s                   = q.get_shape();
+    const auto& kt_s                  = kt.get_shape();
+    const auto& v_s                   = v.get_shape();
+    const auto& mask_s                = mask.get_shape();
+    auto ndim                         = out_s.ndim();
+    auto m                            = out_s.lens()[ndim - 2];
+    auto dv                           = out_s.lens()[ndim - 1];
+    auto dk                           = q_s.lens()[ndim - 1];
+    auto n                            = kt_s.lens()[ndim - 1];
+    auto batch_lens                   = out_s.lens();
+    batch_lens[ndim - 2]              = 1;
+    batch_lens[ndim - 1]              = 1;
+    shape batch_shape{shape::int32_type, batch_lens};
+    auto row_stride = [&](const shape& s) { return s.strides()[ndim - 2]; };
+    auto col_stride = [&](const shape& s) { return s.strides()[ndim - 1]; };
+    // The number of keys query i attends to
+    auto key_end = [&](std::size_t i) -> std::size_t {
+        if(not causal)
+            return n;
+        auto end = static_cast<std::ptrdiff_t>(i + n) - static_cast<std::ptrdiff_t>(m) + 1;
+        return std::clamp<std::ptrdiff_t>(end, 0, n);
+    };
+    auto nqblocks = (m + query_block - 1) / query_block;
+
+    par_for(batch_shape.elements() * nqblocks, 1, [&](std::size_t t) {
+        auto idx          = batch_shape.multi(t / nqblocks);
+        auto first_row    = (t % nqblocks) * query_block;
+        auto nrows        = std::min(query_block, m - first_row);
+        const auto* qp    = q.data() + q_s.index(idx);
+        const auto* ktp   = kt.data() + kt_s.index(idx);
+        const auto* vp    = v.data() + v_s.index(idx);
+        const auto* maskp = mask.empty() ? nullptr : mask.data() + mask_s.index(idx);
+        auto* outp        = output.data() + out_s.index(idx);
+
+        std::array<softmax_state<value_type>, query_block> states{};
+        std::array<value_type, key_block> scores;
+        std::vector<value_type> acc(nrows * dv, 0);
+        auto last = key_end(first_row + nrows - 1);
+        for(std::size_t kb = 0; kb < last; kb += key_block)
+        {
+            for(std::size_t r = 0; r < nrows; r++)
+            {
+                auto i   = first_row + r;
+                auto end = std::min(kb + key_block, key_end(i));
+                if(end <= kb)
+                    continue;
+                auto len = end - kb;
+                for(std::size_t j = 0; j < len; j++)
+                {
+                    const auto* qr = qp + i * row_stride(q_s);
+                    const auto* kc = ktp + (kb + j) * col_stride(kt_s);
+                    value_type s   = 0;
+                    for(std::size_t x = 0; x < dk; x++)
+                        s += value_type(qr[x * col_stride(q_s)]) *
+                             value_type(kc[x * row_stride(kt_s)]);
+                    s *= scale;
+                    if(maskp != nullptr)
+                        s += maskp[i * row_stride(mask_s) + (kb + j) * col_stride(mask_s)];
+                    scores[j] = s;
+                }
+                auto rescale = states[r].exp_add(scores.begin(), scores.begin() + len);
+                auto* a      = acc.data() + r * dv;
+                if(rescale != 1)
+                    std::transform(a, a + dv, a, [&](auto y) { return y * rescale; });
+                for(std::size_t j = 0; j < len; j++)
+                {
+                    const auto* vr = vp + (kb + j) * row_stride(v_s);
+                    for(std::size_t x = 0; x < dv; x++)
+                        a[x] += scores[j] * value_type(vr[x * col_stride(v_s)]);
+                }
+            }
+        }
+        for(std::size_t r = 0; r < nrows; r++)
+        {
+            auto sum      = states[r].sum;
+            const auto* a = acc.data() + r * dv;
+            auto* out     = outp + (first_row + r) * row_stride(out_s);
+            // Queries that attend to no keys are 0
+            for(std::size_t x = 0; x < dv; x++)
+                out[x * col_stride(out_s)] = sum == 0 ? value_type(0) : a[x] / sum;
+        }
+    });
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
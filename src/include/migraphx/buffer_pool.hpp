@@ -0,0 +1,100 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_BUFFER_POOL_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_BUFFER_POOL_HPP
+
+#include <migraphx/config.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct buffer_pool_impl;
+
+/**
+ * @brief Pool of host buffers grouped by size class
+ *
+ * Buffers are rounded up to a size class, with four classes between
+ * consecutive powers of two so at most a quarter of a buffer is wasted. When
+ * the last reference to a buffer is released it is kept in the pool so it can
+ * be handed out again by a later allocation of the same size class instead of
+ * going back to the system allocator, as long as the pool holds less than
+ * `max_bytes` of free buffers. Buffers are always zero-initialized, the same
+ * as `make_shared_array`. Copies of a pool refer to the same buffers.
+ */
+struct MIGRAPHX_EXPORT buffer_pool
+{
+    struct statistics
+    {
+        /// Number of allocations reusing a buffer from the pool
+        std::size_t hits = 0;
+        /// Number of allocations that needed a new buffer
+        std::size_t misses = 0;
+        /// Bytes of the free buffers currently kept in the pool
+        std::size_t bytes_held = 0;
+    };
+
+    /// Default limit on the bytes of free buffers kept in the pool
+    static constexpr std::size_t default_max_bytes = std::size_t{256} << 20u;
+
+    /// Free buffers are only kept while the pool holds at most `max_bytes`
+    explicit buffer_pool(std::size_t max_bytes = default_max_bytes);
+
+    std::shared_ptr<char> allocate(std::size_t n) const;
+
+    statistics get_statistics() const;
+
+    /// Release free buffers back to the system until at most `max_bytes` is held
+    void trim(std::size_t max_bytes = 0) const;
+
+    private:
+    std::shared_ptr<buffer_pool_impl> impl;
+};
+
+/// Returns the pool used by `argument(const shape&)` on this thread, or nullptr
+MIGRAPHX_EXPORT buffer_pool* get_current_buffer_pool();
+
+/**
+ * @brief Use a buffer pool for allocations on the current thread
+ *
+ * While the scope is alive `argument(const shape&)` draws its buffers from
+ * the pool, or from the system allocator when the pool is nullptr. Scopes can
+ * be nested, and the previous pool is restored when the scope ends.
+ */
+struct MIGRAPHX_EXPORT buffer_pool_scope
+{
+    explicit buffer_pool_scope(buffer_pool* p);
+    buffer_pool_scope(const buffer_pool_scope&) = delete;
+    buffer_pool_scope& operator=(const buffer_pool_scope&) = delete;
+    ~buffer_pool_scope();
+
+    private:
+    buffer_pool* prev = nullptr;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_BUFFER_POOL_HPP
@@ -27,6 +27,7 @@
 #include <migraphx/context.hpp>
 #include <migraphx/errors.hpp>
 #include <migraphx/argument.hpp>
+#include <migraphx/lifetime.hpp>
 #include <migraphx/reflect.hpp>
 #include <migraphx/config.hpp>
 
@@ -87,6 +88,32 @@ struct param
     }
 };
 
+/// A buffer owned by the program that keeps its value between evaluations
+struct state
+{
+    std::string variable;
+    shape s;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.variable, "variable"), f(self.s, "shape"));
+    }
+
+    std::string name() const { return "@state"; }
+    shape compute_shape(const std::vector<shape>&) const { return s; }
+    argument compute(context&, const shape&, const std::vector<argument>&) const
+    {
+        MIGRAPHX_THROW("builtin");
+    }
+    lifetime get_lifetime() const { return lifetime::global; }
+    friend std::ostream& operator<<(std::ostream& os, const state& op)
+    {
+        os << op.name() << ":" << op.variable;
+        return os;
+    }
+};
+
 struct returns
 {
     std::string name() const { return "@return"; }
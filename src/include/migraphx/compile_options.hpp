@@ -26,6 +26,7 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/tracer.hpp>
+#include <cstddef>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -41,6 +42,23 @@ struct compile_options
     bool fast_math       = true;
     bool exhaustive_tune = false;
 
+    /**
+     * When the program has dynamic input shapes, compile it lazily instead: the first eval with
+     * new input shapes compiles a copy of the program specialized to those static shapes, and
+     * up to this many of them are kept for the evals that follow. Zero disables it.
+     */
+    std::size_t specialize_cache_size = 0;
+
+    /// Compile the specializations for the optimals of the dynamic dimensions in the background
+    bool precompile_optimals = false;
+
+    /**
+     * Only compile the optimals and the max of a single dynamic dimension, and pad the inputs of
+     * the other sizes with bucket_pad_value up to the next one of them.
+     */
+    bool bucket_dynamic_shapes = false;
+    float bucket_pad_value     = 0;
+
     tracer trace{};
 };
 
@@ -0,0 +1,193 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_CONVERT_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_CONVERT_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/bit_cast.hpp>
+#include <migraphx/float8.hpp>
+#include <migraphx/half.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/requires.hpp>
+#include <migraphx/shape.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+template <class T>
+struct is_fp8 : std::false_type
+{
+};
+
+template <fp8::f8_type F, bool FNUZ>
+struct is_fp8<fp8::float8<F, FNUZ>> : std::true_type
+{
+};
+
+/// Types that are converted to float through a table indexed by their bits
+template <class T>
+struct has_float_table : std::integral_constant<bool, is_fp8<T>{} or std::is_same<T, half>{}>
+{
+};
+
+/// Unsigned integer with the bits of T, used to index its float table
+template <class T>
+using float_table_index = std::conditional_t<sizeof(T) == 1, std::uint8_t, std::uint16_t>;
+
+/**
+ * Convert x to U the way the convert operator does: NaNs become the NaN of U (or 0 for
+ * integers), and values out of the range of U are clamped to its lowest or max value instead
+ * of overflowing.
+ */
+template <class U, class T>
+auto convert_value(T x)
+{
+    shape::as<U> as;
+    // clamping value between target_type's max and min doesn't work for NaNs,
+    if(std::isnan(static_cast<double>(x)))
+        return as.nan();
+    // clamp overflowing/underflowing values to min()/max() instead of +/-infinity
+    // during downcasting
+    return std::min(std::max(as(x), as.min()), as.max());
+}
+
+/// The float value of every bit pattern of T
+template <class T, MIGRAPHX_REQUIRES(has_float_table<T>{})>
+const std::vector<float>& float_table()
+{
+    static const std::vector<float> table = [] {
+        std::vector<float> result(std::size_t{1} << (8 * sizeof(T)));
+        for(std::size_t i = 0; i < result.size(); i++)
+            result[i] = static_cast<float>(bit_cast<T>(static_cast<float_table_index<T>>(i)));
+        return result;
+    }();
+    return table;
+}
+
+/// Convert x to double, through float_table for the types that have one
+template <class T>
+double to_double(T x)
+{
+    if constexpr(has_float_table<T>{})
+        return float_table<T>()[bit_cast<float_table_index<T>>(x)];
+    else
+        return static_cast<double>(x);
+}
+
+/**
+ * Conversion from float to a fp8 type through tables indexed by the upper 16 bits of the
+ * float. Those hold the sign, the exponent and enough of the mantissa to find the rounding bit
+ * of every fp8 format, including their denormals. Rounding to nearest even only needs to know
+ * in addition whether any of the lower 16 bits are set, so there is one table for when they
+ * are all zero and one for when they are not. This also keeps NaNs whose payload is only in
+ * the lower bits apart from infinity.
+ */
+template <class U>
+struct from_float_table
+{
+    std::vector<U> exact;
+    std::vector<U> sticky;
+
+    from_float_table() : exact(1 << 16), sticky(1 << 16)
+    {
+        for(std::uint32_t i = 0; i < exact.size(); i++)
+        {
+            exact[i]  = convert_value<U>(bit_cast<float>(i << 16u));
+            sticky[i] = convert_value<U>(bit_cast<float>((i << 16u) | 1u));
+        }
+    }
+
+    U operator()(float x) const
+    {
+        auto bits = bit_cast<std::uint32_t>(x);
+        auto i    = bits >> 16u;
+        return (bits & 0xffffu) == 0 ? exact[i] : sticky[i];
+    }
+
+    static const from_float_table& get()
+    {
+        static const from_float_table table{};
+        return table;
+    }
+};
+
+/**
+ * Convert n elements from src to dst with the same results as convert_value. Elements are
+ * converted in blocks in parallel. The fp8 and half types are first expanded to float with
+ * float_table, and floats are converted to the fp8 types with from_float_table, so the bit
+ * manipulation of the scalar conversions is only done once for each bit pattern.
+ */
+template <class T, class U>
+void convert_n(const T* src, U* dst, std::size_t n)
+{
+    constexpr std::size_t block = 256;
+    par_for((n + block - 1) / block, 16, [&](std::size_t b) {
+        const auto first = b * block;
+        const auto len   = std::min(block, n - first);
+        const T* s       = src + first;
+        U* d             = dst + first;
+        if constexpr(has_float_table<T>{} or std::is_same<T, float>{})
+        {
+            std::array<float, block> buffer;
+            const float* f = buffer.data();
+            if constexpr(std::is_same<T, float>{})
+            {
+                f = s;
+            }
+            else
+            {
+                const auto& table = float_table<T>();
+                for(std::size_t i = 0; i < len; i++)
+                    buffer[i] = table[bit_cast<float_table_index<T>>(s[i])];
+            }
+            if constexpr(is_fp8<U>{})
+            {
+                const auto& table = from_float_table<U>::get();
+                for(std::size_t i = 0; i < len; i++)
+                    d[i] = table(f[i]);
+            }
+            else
+            {
+                for(std::size_t i = 0; i < len; i++)
+                    d[i] = convert_value<U>(f[i]);
+            }
+        }
+        else
+        {
+            for(std::size_t i = 0; i < len; i++)
+                d[i] = convert_value<U>(s[i]);
+        }
+    });
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_CONVERT_HPP
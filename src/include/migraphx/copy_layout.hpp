@@ -0,0 +1,176 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_COPY_LAYOUT_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_COPY_LAYOUT_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/reduce_dims.hpp>
+#include <migraphx/tensor_view.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Copy input into output, where both have the same lens but can have any strides. The
+ * dimensions are collapsed with reduce_dims first, and then the copy is done a row at a time
+ * along the innermost dimension of the output:
+ *
+ * - rows that are contiguous on both sides are copied with memcpy,
+ * - a transpose, where the input is contiguous along another dimension, is copied in square
+ *   tiles so the strided side stays in cache,
+ * - anything else is copied with a strided loop.
+ *
+ * The rows (or tiles) are distributed with par_for over the remaining outer dimensions.
+ */
+template <class T, class U>
+void copy_layout(tensor_view<T> output, tensor_view<U> input)
+{
+    static_assert(std::is_same<std::remove_cv_t<T>, std::remove_cv_t<U>>{},
+                  "copy_layout does not convert types");
+    constexpr std::size_t min_work = 1024 * 16;
+    constexpr std::size_t tile     = 32;
+    assert(output.get_shape().lens() == input.get_shape().lens());
+    if(output.get_shape().elements() == 0)
+        return;
+
+    auto shapes          = reduce_dims({output.get_shape(), input.get_shape()});
+    const auto& lens     = shapes[0].lens();
+    const auto& ostrides = shapes[0].strides();
+    const auto& istrides = shapes[1].strides();
+    auto* dst            = output.data();
+    const auto* src      = input.data();
+
+    auto grain = [&](std::size_t work) {
+        return std::max<std::size_t>(1, min_work / std::max<std::size_t>(1, work));
+    };
+    auto copy_run = [&](T* out, const U* in, std::size_t n) {
+        if constexpr(std::is_trivially_copyable<T>{})
+            std::memcpy(out, in, n * sizeof(T));
+        else
+            std::copy(in, in + n, out);
+    };
+
+    // Both sides are a single contiguous run, so split it into chunks
+    if(lens.size() == 1 and ostrides[0] == 1 and istrides[0] == 1)
+    {
+        auto n       = lens[0];
+        auto nchunks = (n + min_work - 1) / min_work;
+        par_for(nchunks, 1, [&](std::size_t i) {
+            auto start = i * min_work;
+            copy_run(dst + start, src + start, std::min(min_work, n - start));
+        });
+        return;
+    }
+
+    auto ndim        = lens.size();
+    auto find_stride = [&](const auto& strides, std::size_t skip) {
+        std::size_t result = ndim;
+        for(std::size_t d = 0; d < ndim; d++)
+        {
+            if(d == skip or lens[d] < 2)
+                continue;
+            if(result == ndim or strides[d] < strides[result])
+                result = d;
+        }
+        return result;
+    };
+    // The dimension the output is written along
+    auto a = find_stride(ostrides, ndim);
+    if(a == ndim)
+        a = ndim - 1;
+    // The dimension the input is contiguous along, when it is not a
+    auto b = find_stride(istrides, a);
+    if(istrides[a] == 1 or b == ndim or istrides[b] != 1)
+        b = ndim;
+
+    std::vector<std::size_t> outer_dims;
+    for(std::size_t d = 0; d < ndim; d++)
+    {
+        if(d != a and d != b)
+            outer_dims.push_back(d);
+    }
+    std::size_t outer = 1;
+    for(auto d : outer_dims)
+        outer *= lens[d];
+    auto offsets = [&](std::size_t i) {
+        std::array<std::size_t, 2> result = {0, 0};
+        for(auto it = outer_dims.rbegin(); it != outer_dims.rend(); ++it)
+        {
+            auto k = i % lens[*it];
+            i /= lens[*it];
+            result[0] += k * ostrides[*it];
+            result[1] += k * istrides[*it];
+        }
+        return result;
+    };
+
+    auto row = lens[a];
+    if(b != ndim)
+    {
+        auto nb = (lens[b] + tile - 1) / tile;
+        par_for(outer * nb, grain(tile * row), [&](std::size_t i) {
+            auto off = offsets(i / nb);
+            auto b0  = (i % nb) * tile;
+            auto b1  = std::min(lens[b], b0 + tile);
+            for(std::size_t a0 = 0; a0 < row; a0 += tile)
+            {
+                auto a1 = std::min(row, a0 + tile);
+                for(std::size_t jb = b0; jb < b1; jb++)
+                {
+                    auto* out      = dst + off[0] + jb * ostrides[b];
+                    const auto* in = src + off[1] + jb;
+                    for(std::size_t ja = a0; ja < a1; ja++)
+                        out[ja * ostrides[a]] = in[ja * istrides[a]];
+                }
+            }
+        });
+    }
+    else if(ostrides[a] == 1 and istrides[a] == 1)
+    {
+        par_for(outer, grain(row), [&](std::size_t i) {
+            auto off = offsets(i);
+            copy_run(dst + off[0], src + off[1], row);
+        });
+    }
+    else
+    {
+        par_for(outer, grain(row), [&](std::size_t i) {
+            auto off       = offsets(i);
+            auto* out      = dst + off[0];
+            const auto* in = src + off[1];
+            for(std::size_t j = 0; j < row; j++)
+                out[j * ostrides[a]] = in[j * istrides[a]];
+        });
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_COPY_LAYOUT_HPP
@@ -0,0 +1,78 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_AMDMIGRAPHX_MATCH_ATTENTION_HPP
+#define MIGRAPHX_GUARD_AMDMIGRAPHX_MATCH_ATTENTION_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/matcher.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace match {
+
+namespace detail {
+struct attention_matcher
+{
+    static auto last_axis()
+    {
+        return make_basic_pred_matcher([](instruction_ref ins) {
+            auto axis = ins->get_operator().to_value()["axis"].to<std::int64_t>();
+            auto ndim = static_cast<std::int64_t>(ins->get_shape().ndim());
+            return axis == -1 or axis == ndim - 1;
+        });
+    }
+
+    // The scores are matched more than once, so they are type-erased to keep the type of the
+    // whole matcher small
+    static any_matcher scores()
+    {
+        any_matcher gemm = skip(name("contiguous"))(
+            name("dot")(used_once(), arg(0)(any().bind("q")), arg(1)(any().bind("kt"))));
+        auto mul = name("mul")(used_once(), either_arg(0, 1)(is_constant().bind("scale"), gemm));
+        auto div =
+            name("div")(used_once(), arg(0)(gemm), arg(1)(is_constant().bind("inv_scale")));
+        return any_of(mul, div, gemm);
+    }
+
+    auto matcher() const
+    {
+        auto add     = name("add")(used_once(), either_arg(0, 1)(scores(), any().bind("mask")));
+        auto softmax = name("softmax")(used_once(), last_axis(), arg(0)(any_of(add, scores())));
+        return name("dot")(arg(0)(softmax), arg(1)(any().bind("v")));
+    }
+};
+} // namespace detail
+
+/**
+ * Matches scaled dot product attention, dot(softmax(dot(q, kt) * scale + mask), v), where the
+ * softmax is over the last axis. The scale can be a constant multiplier or divisor, and both
+ * it and the mask are optional.
+ */
+inline auto attention() { return detail::attention_matcher{}.matcher(); }
+
+} // namespace match
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -174,6 +174,10 @@ struct MIGRAPHX_EXPORT module
 
     instruction_ref add_parameter(std::string name, shape s);
 
+    /// Add a buffer called name that is allocated by the program and keeps its value between
+    /// evaluations. Every state with the same name refers to the same buffer.
+    instruction_ref add_state(std::string name, shape s);
+
     instruction_ref add_return(std::vector<instruction_ref> args);
 
     instruction_ref replace_return(std::vector<instruction_ref> args);
@@ -182,6 +186,8 @@ struct MIGRAPHX_EXPORT module
 
     instruction_ref insert_parameter(instruction_ref ins, std::string name, shape s);
 
+    instruction_ref insert_state(instruction_ref ins, std::string name, shape s);
+
     std::vector<std::string> get_parameter_names() const;
 
     shape get_parameter_shape(std::string name) const;
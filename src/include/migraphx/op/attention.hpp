@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_ATTENTION_HPP
+#define MIGRAPHX_GUARD_OPERATORS_ATTENTION_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/errors.hpp>
+#include <algorithm>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * Scaled dot product attention: softmax(scale * q * kt + mask) * v, with the softmax over the
+ * last axis. The inputs are q [..., m, k], kt [..., k, n], an optional additive mask
+ * [..., m, n] and v [..., n, o], and the output is [..., m, o]. With causal, query i only
+ * attends to the keys up to i + n - m.
+ */
+struct attention
+{
+    float scale = 1.0;
+    bool causal = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.scale, "scale"), f(self.causal, "causal"));
+    }
+
+    std::string name() const { return "attention"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(3, 4).same_type().same_ndims().min_ndims(2);
+        const auto& q   = inputs[0];
+        const auto& kt  = inputs[1];
+        const auto& v   = inputs.back();
+        auto ndim       = q.ndim();
+        auto lens       = q.lens();
+        auto same_batch = [&](const shape& s) {
+            return std::equal(lens.begin(), lens.end() - 2, s.lens().begin());
+        };
+        if(not same_batch(kt) or not same_batch(v))
+            MIGRAPHX_THROW("ATTENTION: batch dimensions of the inputs do not match");
+        if(q.lens()[ndim - 1] != kt.lens()[ndim - 2])
+            MIGRAPHX_THROW("ATTENTION: inner dimensions of q and kt do not match");
+        if(kt.lens()[ndim - 1] != v.lens()[ndim - 2])
+            MIGRAPHX_THROW("ATTENTION: number of keys of kt and v do not match");
+        if(inputs.size() == 4)
+        {
+            auto score_lens   = lens;
+            score_lens.back() = kt.lens().back();
+            if(inputs[2].lens() != score_lens)
+                MIGRAPHX_THROW("ATTENTION: mask does not have the dimensions of the scores");
+        }
+        lens.back() = v.lens().back();
+        return {q.type(), lens};
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -31,6 +31,7 @@
 #include <migraphx/streamutils.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/shape_for_each.hpp>
+#include <migraphx/copy_layout.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
 #include <migraphx/permutation.hpp>
@@ -155,7 +156,7 @@ struct concat
                                          input.get_shape().lens(),
                                          dyn_out.computed_shape.strides()};
                 auto slice       = make_view(slice_shape, output.data() + coffsets[l]);
-                std::copy(input.begin(), input.end(), slice.begin());
+                copy_layout(slice, input);
             });
         }
         return result;
@@ -25,6 +25,7 @@
 #define MIGRAPHX_GUARD_OPERATORS_CONVERT_HPP
 
 #include <migraphx/config.hpp>
+#include <migraphx/convert.hpp>
 #include <migraphx/op/unary.hpp>
 #include <cmath>
 
@@ -61,24 +62,36 @@ struct convert : unary<convert>
         return "${function:convert}<" + shape::cpp_type(target_type) + ">(${0})";
     }
 
-    auto apply() const
+    argument compute(const dyn_output& dyn_out, std::vector<argument> args) const
     {
-        auto type = target_type;
-        return [type](auto x) {
-            auto y = x;
-            shape::visit(type, [&](auto as) {
-                // clamping value between target_type's max and min doesn't work for NaNs,
-                if(std::isnan(static_cast<double>(x)))
+        argument result{dyn_out.computed_shape};
+        result.visit([&](auto output) {
+            using type = typename decltype(output)::value_type;
+            args[0].visit([&](auto input) {
+                // The output has the same strides as the input, so the elements can be converted
+                // directly in memory order unless the input skips over some of them
+                const auto& s = input.get_shape();
+                if(s.element_space() <= s.elements())
                 {
-                    y = as.nan();
+                    convert_n(input.data(), output.data(), s.element_space());
                 }
                 else
                 {
-                    // clamp overflowing/underflowing values to min()/max() instead of +/-infinity
-                    // during downcasting
-                    y = std::min(std::max(as(x), as.min()), as.max());
+                    std::transform(input.begin(), input.end(), output.begin(), [](auto x) {
+                        return convert_value<type>(x);
+                    });
                 }
             });
+        });
+        return result;
+    }
+
+    auto apply() const
+    {
+        auto type = target_type;
+        return [type](auto x) {
+            auto y = x;
+            shape::visit(type, [&](auto as) { y = convert_value<typename decltype(as)::type>(x); });
             return y;
         };
     }
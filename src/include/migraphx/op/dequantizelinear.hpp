@@ -26,6 +26,7 @@
 
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/config.hpp>
+#include <migraphx/convert.hpp>
 #include <migraphx/argument.hpp>
 #include <migraphx/par_for.hpp>
 #include <migraphx/value.hpp>
@@ -72,9 +73,7 @@ struct dequantizelinear
         visit_all(x, x_zero_point)([&](auto input, auto zero_pts) {
             visit_all(result, x_scale)([&](auto output, auto scales) {
                 par_for(output_shape.elements(), [&](auto i) {
-                    output[i] = static_cast<double>(static_cast<double>(input[i]) -
-                                                    static_cast<double>(zero_pts[i])) *
-                                scales[i];
+                    output[i] = (to_double(input[i]) - to_double(zero_pts[i])) * scales[i];
                 });
             });
         });
@@ -32,9 +32,13 @@
 #include <migraphx/literal.hpp>
 #include <migraphx/shape_for_each.hpp>
 #include <migraphx/config.hpp>
+#include <migraphx/par_for.hpp>
 #include <migraphx/value.hpp>
 #include <migraphx/op/normalize_attribute.hpp>
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <numeric>
 #include <utility>
 
 namespace migraphx {
@@ -120,6 +124,39 @@ struct gather
                     in_index      = (in_index < 0) ? in_index + axis_dim_size : in_index;
                     output[0]     = data[in_index];
                 }
+                else if(data.get_shape().standard())
+                {
+                    // Every index selects a contiguous slab of the elements after the axis, so
+                    // the slabs are copied whole, with the indices checked once up front
+                    std::size_t outer = std::accumulate(lens.begin(),
+                                                        lens.begin() + axis,
+                                                        std::size_t{1},
+                                                        std::multiplies<std::size_t>());
+                    std::size_t inner = std::accumulate(lens.begin() + axis + 1,
+                                                        lens.end(),
+                                                        std::size_t{1},
+                                                        std::multiplies<std::size_t>());
+                    std::size_t n     = indices.get_shape().elements();
+                    std::vector<std::size_t> offsets(n);
+                    std::transform(indices.begin(), indices.end(), offsets.begin(), [&](auto i) {
+                        int64_t in_index = i;
+                        if(in_index < -static_cast<int64_t>(axis_dim_size) or
+                           in_index >= static_cast<int64_t>(axis_dim_size))
+                            MIGRAPHX_THROW("Gather: index " + std::to_string(in_index) +
+                                           " is out of bounds for dim of len " +
+                                           std::to_string(axis_dim_size));
+                        if(in_index < 0)
+                            in_index += axis_dim_size;
+                        return in_index * inner;
+                    });
+                    const auto* src   = data.data();
+                    auto* dst         = output.data();
+                    std::size_t grain = 4096 / std::max<std::size_t>(1, inner);
+                    par_for(outer * n, std::max<std::size_t>(1, grain), [&](auto i) {
+                        const auto* slab = src + (i / n) * axis_dim_size * inner + offsets[i % n];
+                        std::copy_n(slab, inner, dst + i * inner);
+                    });
+                }
                 else
                 {
                     auto out_lens  = data.get_shape().lens();
@@ -29,6 +29,7 @@
 #include <migraphx/shape_for_each.hpp>
 #include <migraphx/par_for.hpp>
 #include <migraphx/argument.hpp>
+#include <algorithm>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -208,10 +209,23 @@ struct gathernd
                         (batch_idx * data_batch_stride) + relative_slice_offset;
                 });
 
-                par_for(num_slices * slice_size, [&](const auto i) {
-                    auto slice_offset = input_slice_offsets[i / slice_size];
-                    output[i]         = data[slice_offset + i % slice_size];
-                });
+                if(data_shape.standard())
+                {
+                    // The slices are contiguous in the data, so copy each of them whole
+                    const auto* src   = data.data();
+                    auto* dst         = output.data();
+                    std::size_t grain = 4096 / std::max<std::size_t>(1, slice_size);
+                    par_for(num_slices, std::max<std::size_t>(1, grain), [&](auto i) {
+                        std::copy_n(src + input_slice_offsets[i], slice_size, dst + i * slice_size);
+                    });
+                }
+                else
+                {
+                    par_for(num_slices * slice_size, [&](const auto i) {
+                        auto slice_offset = input_slice_offsets[i / slice_size];
+                        output[i]         = data[slice_offset + i % slice_size];
+                    });
+                }
             });
         });
 
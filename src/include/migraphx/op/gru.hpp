@@ -35,6 +35,7 @@
 #include <migraphx/literal.hpp>
 #include <migraphx/shape_for_each.hpp>
 #include <migraphx/config.hpp>
+#include <migraphx/rnn.hpp>
 #include <cmath>
 #include <utility>
 
@@ -49,6 +50,8 @@ struct gru
     rnn_direction direction = rnn_direction::forward;
     float clip              = 0.0f;
     int linear_before_reset = 0;
+    /// Also output the last hidden state, in a tuple after the hidden states
+    bool last_outputs = false;
 
     template <class Self, class F>
     static auto reflect(Self& self, F f)
@@ -57,7 +60,8 @@ struct gru
                     f(self.actv_funcs, "actv_func"),
                     f(self.direction, "direction"),
                     f(self.clip, "clip"),
-                    f(self.linear_before_reset, "linear_before_reset"));
+                    f(self.linear_before_reset, "linear_before_reset"),
+                    f(self.last_outputs, "last_outputs"));
     }
 
     std::string name() const { return "gru"; }
@@ -85,7 +89,62 @@ struct gru
         out_dims.insert(out_dims.begin() + 1, num_directions);
         out_dims.back() = hidden_size;
 
-        return {inputs[0].type(), out_dims};
+        shape hidden_states{inputs[0].type(), out_dims};
+        if(not last_outputs)
+            return hidden_states;
+        shape last{inputs[0].type(), {num_directions, in_dims[1], hidden_size}};
+        return shape{{hidden_states, last}};
+    }
+
+    /// The two activation functions of every direction, filled in the way parse_gru does
+    std::vector<operation> get_actv_funcs() const
+    {
+        if(direction == rnn_direction::bidirectional)
+        {
+            if(actv_funcs.empty())
+                return {sigmoid{}, tanh{}, sigmoid{}, tanh{}};
+            else if(actv_funcs.size() == 1)
+                return {actv_funcs.at(0), actv_funcs.at(0), actv_funcs.at(0), actv_funcs.at(0)};
+            else if(actv_funcs.size() == 2)
+                return {actv_funcs.at(0), actv_funcs.at(1), actv_funcs.at(0), actv_funcs.at(1)};
+            else if(actv_funcs.size() == 3)
+                return {actv_funcs.at(0), actv_funcs.at(1), actv_funcs.at(2), actv_funcs.at(0)};
+            else
+                return actv_funcs;
+        }
+        else
+        {
+            if(actv_funcs.empty())
+                return {sigmoid{}, tanh{}};
+            else if(actv_funcs.size() == 1)
+                return {actv_funcs.at(0), actv_funcs.at(0)};
+            else
+                return actv_funcs;
+        }
+    }
+
+    /// Write the outputs into result, which is a tuple of them when last_outputs is set
+    void compute_into(const argument& result, const std::vector<argument>& args) const
+    {
+        auto outputs = last_outputs ? result.get_sub_objects() : std::vector<argument>{result};
+        outputs.front().visit([&](auto hidden_states) {
+            using type   = typename decltype(hidden_states)::value_type;
+            auto last_hs = last_outputs ? outputs[1].get<type>() : tensor_view<type>{};
+            migraphx::gru(hidden_states,
+                          last_hs,
+                          args,
+                          get_actv_funcs(),
+                          direction,
+                          clip,
+                          linear_before_reset != 0);
+        });
+    }
+
+    argument compute(const shape& output_shape, const std::vector<argument>& args) const
+    {
+        argument result{output_shape};
+        compute_into(result, args);
+        return result;
     }
 };
 
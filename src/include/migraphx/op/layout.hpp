@@ -27,6 +27,7 @@
 #include <migraphx/config.hpp>
 #include <array>
 #include <migraphx/check_shapes.hpp>
+#include <migraphx/copy_layout.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/streamutils.hpp>
 #include <migraphx/literal.hpp>
@@ -56,6 +57,13 @@ struct layout : unary<layout>
         return shape::from_permutation(t, lens, permutation);
     }
 
+    argument compute(const dyn_output& dyn_out, std::vector<argument> args) const
+    {
+        argument result{dyn_out.computed_shape};
+        visit_all(result, args[0])([&](auto output, auto input) { copy_layout(output, input); });
+        return result;
+    }
+
     auto apply() const
     {
         return [](auto x) { return x; };
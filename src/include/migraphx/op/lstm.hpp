@@ -35,6 +35,7 @@
 #include <migraphx/literal.hpp>
 #include <migraphx/shape_for_each.hpp>
 #include <migraphx/config.hpp>
+#include <migraphx/rnn.hpp>
 #include <cmath>
 #include <utility>
 
@@ -49,6 +50,8 @@ struct lstm
     rnn_direction direction = rnn_direction::forward;
     float clip              = 0.0f;
     int input_forget        = 0;
+    /// Also output the last hidden and cell states, in a tuple after the hidden states
+    bool last_outputs = false;
 
     template <class Self, class F>
     static auto reflect(Self& self, F f)
@@ -57,7 +60,8 @@ struct lstm
                     f(self.actv_funcs, "actv_func"),
                     f(self.direction, "direction"),
                     f(self.clip, "clip"),
-                    f(self.input_forget, "input_forget"));
+                    f(self.input_forget, "input_forget"),
+                    f(self.last_outputs, "last_outputs"));
     }
 
     std::string name() const { return "lstm"; }
@@ -85,7 +89,105 @@ struct lstm
         out_dims.insert(out_dims.begin() + 1, num_directions);
         out_dims.back() = hidden_size;
 
-        return {inputs[0].type(), out_dims};
+        shape hidden_states{inputs[0].type(), out_dims};
+        if(not last_outputs)
+            return hidden_states;
+        shape last{inputs[0].type(), {num_directions, in_dims[1], hidden_size}};
+        return shape{{hidden_states, last, last}};
+    }
+
+    /// The three activation functions of every direction, filled in the way parse_lstm does
+    std::vector<operation> get_actv_funcs() const
+    {
+        std::size_t num_actv_funcs = actv_funcs.size();
+        if(direction == rnn_direction::bidirectional)
+        {
+            switch(num_actv_funcs)
+            {
+            case 0: return {sigmoid{}, tanh{}, tanh{}, sigmoid{}, tanh{}, tanh{}};
+
+            case 1:
+                return {actv_funcs.at(0),
+                        actv_funcs.at(0),
+                        actv_funcs.at(0),
+                        actv_funcs.at(0),
+                        actv_funcs.at(0),
+                        actv_funcs.at(0)};
+
+            case 2:
+                return {actv_funcs.at(0),
+                        actv_funcs.at(1),
+                        actv_funcs.at(1),
+                        actv_funcs.at(0),
+                        actv_funcs.at(1),
+                        actv_funcs.at(1)};
+
+            case 3:
+                return {actv_funcs.at(0),
+                        actv_funcs.at(1),
+                        actv_funcs.at(2),
+                        actv_funcs.at(0),
+                        actv_funcs.at(1),
+                        actv_funcs.at(2)};
+
+            case 4:
+                return {actv_funcs.at(0),
+                        actv_funcs.at(1),
+                        actv_funcs.at(2),
+                        actv_funcs.at(3),
+                        actv_funcs.at(3),
+                        actv_funcs.at(3)};
+
+            case 5:
+                return {actv_funcs.at(0),
+                        actv_funcs.at(1),
+                        actv_funcs.at(2),
+                        actv_funcs.at(3),
+                        actv_funcs.at(4),
+                        actv_funcs.at(4)};
+
+            default: return actv_funcs;
+            }
+        }
+        else
+        {
+            switch(num_actv_funcs)
+            {
+            case 0: return {sigmoid{}, tanh{}, tanh{}};
+
+            case 1: return {actv_funcs.at(0), actv_funcs.at(0), actv_funcs.at(0)};
+
+            case 2: return {actv_funcs.at(0), actv_funcs.at(1), actv_funcs.at(1)};
+
+            default: return actv_funcs;
+            }
+        }
+    }
+
+    /// Write the outputs into result, which is a tuple of them when last_outputs is set
+    void compute_into(const argument& result, const std::vector<argument>& args) const
+    {
+        auto outputs = last_outputs ? result.get_sub_objects() : std::vector<argument>{result};
+        outputs.front().visit([&](auto hidden_states) {
+            using type     = typename decltype(hidden_states)::value_type;
+            auto last_hs   = last_outputs ? outputs[1].get<type>() : tensor_view<type>{};
+            auto last_cell = last_outputs ? outputs[2].get<type>() : tensor_view<type>{};
+            migraphx::lstm(hidden_states,
+                           last_hs,
+                           last_cell,
+                           args,
+                           get_actv_funcs(),
+                           direction,
+                           clip,
+                           input_forget != 0);
+        });
+    }
+
+    argument compute(const shape& output_shape, const std::vector<argument>& args) const
+    {
+        argument result{output_shape};
+        compute_into(result, args);
+        return result;
     }
 };
 
@@ -38,7 +38,7 @@
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/output_iterator.hpp>
 #include <migraphx/argument.hpp>
-#include <migraphx/par.hpp>
+#include <migraphx/par_for.hpp>
 
 /*
 https://github.com/onnx/onnx/blob/main/docs/Operators.md#NonMaxSuppression
@@ -189,124 +189,128 @@ struct nonmaxsuppression
         }
     }
 
-    struct box
+    // Corners and areas of the boxes of one batch, stored as a struct of arrays
+    struct box_list
     {
-        std::array<double, 2> x;
-        std::array<double, 2> y;
+        std::vector<double> x0;
+        std::vector<double> x1;
+        std::vector<double> y0;
+        std::vector<double> y1;
+        std::vector<double> area;
 
-        void sort()
+        box_list() = default;
+        explicit box_list(std::size_t n) : x0(n), x1(n), y0(n), y1(n), area(n) {}
+
+        void set(std::size_t i, double xa, double xb, double ya, double yb)
         {
-            if(x[0] > x[1])
-            {
-                std::swap(x[0], x[1]);
-            }
-            if(y[0] > y[1])
-            {
-                std::swap(y[0], y[1]);
-            }
+            x0[i]   = std::min(xa, xb);
+            x1[i]   = std::max(xa, xb);
+            y0[i]   = std::min(ya, yb);
+            y1[i]   = std::max(ya, yb);
+            area[i] = (x1[i] - x0[i]) * (y1[i] - y0[i]);
         }
 
-        std::array<double, 2>& operator[](std::size_t i) { return i == 0 ? x : y; }
-
-        double area() const
+        bool suppress(std::size_t i, std::size_t j, double iou_threshold) const
         {
-            assert(x[0] <= x[1]);
-            assert(y[0] <= y[1]);
-            return (x[1] - x[0]) * (y[1] - y[0]);
+            if(area[i] <= .0f or area[j] <= .0f)
+                return false;
+            const double ix0 = std::max(x0[i], x0[j]);
+            const double ix1 = std::min(x1[i], x1[j]);
+            const double iy0 = std::max(y0[i], y0[j]);
+            const double iy1 = std::min(y1[i], y1[j]);
+            if(ix0 > ix1 or iy0 > iy1)
+                return false;
+            const double intersection_area = (ix1 - ix0) * (iy1 - iy0);
+            const double union_area        = area[i] + area[j] - intersection_area;
+            if(union_area <= .0f)
+                return false;
+            return intersection_area / union_area > iou_threshold;
         }
     };
 
     template <class T>
-    box batch_box(T boxes, std::size_t box_idx) const
+    box_list load_boxes(T boxes, std::size_t num_boxes) const
     {
-        box result{};
-        auto start = boxes + 4 * box_idx;
+        box_list result(num_boxes);
         if(center_point_box)
         {
-            double half_width  = start[2] / 2.0;
-            double half_height = start[3] / 2.0;
-            double x_center    = start[0];
-            double y_center    = start[1];
-            result.x           = {x_center - half_width, x_center + half_width};
-            result.y           = {y_center - half_height, y_center + half_height};
+            for(std::size_t i = 0; i < num_boxes; i++)
+            {
+                auto start         = boxes + 4 * i;
+                double half_width  = start[2] / 2.0;
+                double half_height = start[3] / 2.0;
+                double x_center    = start[0];
+                double y_center    = start[1];
+                result.set(i,
+                           x_center - half_width,
+                           x_center + half_width,
+                           y_center - half_height,
+                           y_center + half_height);
+            }
         }
         else
         {
-            result.x = {static_cast<double>(start[1]), static_cast<double>(start[3])};
-            result.y = {static_cast<double>(start[0]), static_cast<double>(start[2])};
+            for(std::size_t i = 0; i < num_boxes; i++)
+            {
+                auto start = boxes + 4 * i;
+                result.set(i, start[1], start[3], start[0], start[2]);
+            }
         }
-
-        result.sort();
-
         return result;
     }
 
-    inline bool suppress_by_iou(box b1, box b2, double iou_threshold) const
+    // Greedily select boxes in descending score order, skipping a box when any previously
+    // selected box suppresses it. Candidates are popped from a heap so only as many as needed
+    // are ordered. The selected boxes are kept sorted by their left edge, so only the ones
+    // whose x-extent can overlap a candidate are tested for IOU.
+    template <class T>
+    std::vector<int64_t> select_boxes(const box_list& bl,
+                                      T scores,
+                                      std::size_t num_boxes,
+                                      std::size_t max_output_boxes_per_class,
+                                      double iou_threshold,
+                                      double score_threshold) const
     {
-        const double area1 = b1.area();
-        const double area2 = b2.area();
-
-        if(area1 <= .0f or area2 <= .0f)
-        {
-            return false;
-        }
-
-        box intersection{};
-        for(auto i : range(2))
-        {
-            intersection[i][0] = std::max(b1[i][0], b2[i][0]);
-            intersection[i][1] = std::min(b1[i][1], b2[i][1]);
-            if(intersection[i][0] > intersection[i][1])
-            {
-                return false;
-            }
-        }
-
-        const double intersection_area = intersection.area();
-        const double union_area        = area1 + area2 - intersection_area;
-
-        if(union_area <= .0f)
+        std::vector<int64_t> candidates;
+        candidates.reserve(num_boxes);
+        for(std::size_t i = 0; i < num_boxes; i++)
         {
-            return false;
+            if(score_threshold <= 0.0 or scores[i] >= score_threshold)
+                candidates.push_back(i);
         }
+        // Order by score, then by index for equal scores
+        auto compare = [&](int64_t a, int64_t b) {
+            return std::make_pair(static_cast<double>(scores[a]), a) <
+                   std::make_pair(static_cast<double>(scores[b]), b);
+        };
+        std::make_heap(candidates.begin(), candidates.end(), compare);
 
-        const double intersection_over_union = intersection_area / union_area;
-
-        return intersection_over_union > iou_threshold;
-    }
-
-    // filter boxes below score_threshold
-    template <class T>
-    std::vector<std::pair<double, int64_t>>
-    filter_boxes_by_score(T scores_start, std::size_t num_boxes, double score_threshold) const
-    {
-        std::vector<std::pair<double, int64_t>> boxes_heap;
-        int64_t box_idx = 0;
+        // Compare the left edge of a box with a position
+        auto before = [&](int64_t i, double x) { return bl.x0[i] < x; };
+        auto after  = [&](double x, int64_t i) { return x < bl.x0[i]; };
 
-        if(score_threshold > 0.0)
+        std::vector<int64_t> selected;
+        std::vector<int64_t> sorted_by_x;
+        double max_width = 0;
+        auto last        = candidates.end();
+        while(last != candidates.begin() and selected.size() < max_output_boxes_per_class)
         {
-            transform_if(
-                scores_start,
-                scores_start + num_boxes,
-                std::back_inserter(boxes_heap),
-                [&](auto sc) {
-                    box_idx++;
-                    return sc >= score_threshold;
-                },
-                [&](auto sc) { return std::make_pair(sc, box_idx - 1); });
+            std::pop_heap(candidates.begin(), last, compare);
+            --last;
+            auto c = *last;
+
+            // Any overlapping box has its left edge in [x0 - max_width, x1]
+            auto first = std::lower_bound(
+                sorted_by_x.begin(), sorted_by_x.end(), bl.x0[c] - max_width, before);
+            auto end   = std::upper_bound(first, sorted_by_x.end(), bl.x1[c], after);
+            if(std::any_of(first, end, [&](int64_t i) { return bl.suppress(i, c, iou_threshold); }))
+                continue;
+            selected.push_back(c);
+            sorted_by_x.insert(
+                std::upper_bound(sorted_by_x.begin(), sorted_by_x.end(), bl.x0[c], after), c);
+            max_width = std::max(max_width, bl.x1[c] - bl.x0[c]);
         }
-        else
-        { // score is irrelevant, just push into boxes_heap and make a score-index pair
-            std::transform(scores_start,
-                           scores_start + num_boxes,
-                           std::back_inserter(boxes_heap),
-                           [&](auto sc) {
-                               box_idx++;
-                               return std::make_pair(sc, box_idx - 1);
-                           });
-        }
-        par_sort(boxes_heap.begin(), boxes_heap.end(), std::greater<std::pair<double, int64_t>>{});
-        return boxes_heap;
+        return selected;
     }
 
     template <class Output, class Boxes, class Scores>
@@ -322,50 +326,33 @@ struct nonmaxsuppression
         const auto num_batches = lens[0];
         const auto num_classes = lens[1];
         const auto num_boxes   = lens[2];
-        // boxes of a class with NMS applied [score, index]
-        std::vector<int64_t> selected_indices;
-        // iterate over batches and classes
-        shape comp_s{shape::double_type, {num_batches, num_classes}};
-        shape_for_each(comp_s, [&](const auto& idx) {
-            auto batch_idx = idx[0];
-            auto class_idx = idx[1];
-            // index offset for this class
-            auto scores_start = scores.begin() + (batch_idx * num_classes + class_idx) * num_boxes;
-            // iterator to first value of this batch
-            auto batch_boxes_start = boxes.begin() + batch_idx * num_boxes * 4;
-            auto boxes_heap = filter_boxes_by_score(scores_start, num_boxes, score_threshold);
-            int64_t selected_boxes_inside_class = 0;
-            while(not boxes_heap.empty() &&
-                  selected_boxes_inside_class < max_output_boxes_per_class)
+        std::vector<box_list> batch_boxes(num_batches);
+        par_for(num_batches, 1, [&](auto batch_idx) {
+            batch_boxes[batch_idx] =
+                load_boxes(boxes.begin() + batch_idx * num_boxes * 4, num_boxes);
+        });
+        // Each (batch, class) pair is independent
+        std::vector<std::vector<int64_t>> selected(num_batches * num_classes);
+        par_for(selected.size(), 1, [&](auto i) {
+            auto batch_idx = i / num_classes;
+            selected[i]    = select_boxes(batch_boxes[batch_idx],
+                                       scores.begin() + i * num_boxes,
+                                       num_boxes,
+                                       max_output_boxes_per_class,
+                                       iou_threshold,
+                                       score_threshold);
+        });
+        auto out = output.begin();
+        for(std::size_t i = 0; i < selected.size(); i++)
+        {
+            for(auto box_idx : selected[i])
             {
-                // select next top scorer box and remove any boxes from boxes_heap that exceeds IOU
-                // threshold with the selected box
-                const auto next_top_score = boxes_heap.front();
-                auto next_box             = batch_box(batch_boxes_start, next_top_score.second);
-                auto next_box_idx         = next_top_score.second;
-
-                selected_boxes_inside_class++;
-                selected_indices.push_back(batch_idx);
-                selected_indices.push_back(class_idx);
-                selected_indices.push_back(next_box_idx);
-
-                std::vector<std::pair<double, int64_t>> remainder_boxes(boxes_heap.size());
-
-                auto it = par_copy_if(
-                    boxes_heap.begin() + 1,
-                    boxes_heap.end(),
-                    remainder_boxes.begin(),
-                    [&](auto iou_candidate_box) {
-                        auto iou_box = batch_box(batch_boxes_start, iou_candidate_box.second);
-                        return not this->suppress_by_iou(iou_box, next_box, iou_threshold);
-                    });
-
-                remainder_boxes.resize(it - remainder_boxes.begin());
-                boxes_heap = remainder_boxes;
+                *out++ = i / num_classes;
+                *out++ = i % num_classes;
+                *out++ = box_idx;
             }
-        });
-        std::copy(selected_indices.begin(), selected_indices.end(), output.begin());
-        return selected_indices.size() / 3;
+        }
+        return std::distance(output.begin(), out) / 3;
     }
 
     argument compute(const shape& output_shape, std::vector<argument> args) const
@@ -24,12 +24,12 @@
 #ifndef MIGRAPHX_GUARD_OPERATORS_NONZERO_HPP
 #define MIGRAPHX_GUARD_OPERATORS_NONZERO_HPP
 
-#include <migraphx/shape_for_each.hpp>
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/float_equal.hpp>
-#include <migraphx/par_for.hpp>
+#include <migraphx/prefix_scan.hpp>
 #include <migraphx/argument.hpp>
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
@@ -53,25 +53,41 @@ struct nonzero
 
     argument compute(const shape& output_shape, std::vector<argument> args) const
     {
-        std::vector<std::vector<std::size_t>> vec_idx;
-        auto s = args.front().get_shape();
-        args.front().visit([&](auto v) {
-            shape_for_each(s, [&](const auto& idx_v, size_t idx) {
-                if(not float_equal(v[idx], 0))
-                {
-                    vec_idx.push_back(idx_v);
-                }
-            });
-        });
-
         argument result{output_shape};
-        result.visit([&](auto output) {
-            std::fill(output.begin(), output.end(), 0);
-            par_for(vec_idx.size(), [&](auto i) {
-                for(std::size_t j = 0; j < vec_idx.front().size(); ++j)
-                {
-                    output[output_shape.index({j, i})] = vec_idx[i][j];
-                }
+        auto s           = args.front().get_shape();
+        const auto& lens = s.lens();
+        auto n           = s.elements();
+        args.front().visit([&](auto v) {
+            const auto* input = v.data();
+            result.visit([&](auto output) {
+                auto* out = output.data();
+                std::fill(out, out + output_shape.elements(), 0);
+                // Each block counts its nonzero elements, and then writes their indices starting
+                // at the count of all the blocks before it
+                block_scan(
+                    n,
+                    scan_block_count(n, 1024),
+                    std::size_t{0},
+                    [](std::size_t x, std::size_t y) { return x + y; },
+                    [&](std::size_t first, std::size_t last) {
+                        return std::count_if(input + first, input + last, [](auto x) {
+                            return not float_equal(x, 0);
+                        });
+                    },
+                    [&](std::size_t first, std::size_t last, std::size_t k) {
+                        for(std::size_t i = first; i < last; i++)
+                        {
+                            if(float_equal(input[i], 0))
+                                continue;
+                            auto idx = i;
+                            for(std::size_t j = lens.size(); j > 0; j--)
+                            {
+                                out[(j - 1) * n + k] = idx % lens[j - 1];
+                                idx /= lens[j - 1];
+                            }
+                            k++;
+                        }
+                    });
             });
         });
 
@@ -34,8 +34,8 @@
 #include <migraphx/op/name.hpp>
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/argument.hpp>
-#include <migraphx/shape_for_each.hpp>
-#include <migraphx/par_for.hpp>
+#include <migraphx/copy_layout.hpp>
+#include <migraphx/prefix_scan.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
 #include <migraphx/op/normalize_attribute.hpp>
@@ -100,44 +100,28 @@ struct prefix_scan_op : op_name<Derived>
         }
         else
         {
-            visit_all(result, args[0])([&](auto output, auto input) {
-                par_for(output_shape.elements(),
-                        [&](auto i) { output[output_shape.index(i)] = input[s.index(i)]; });
-            });
+            visit_all(result, args[0])(
+                [&](auto output, auto input) { copy_layout(output, input); });
             s = output_shape;
         }
-        auto slice = shape{s.type(), {s.lens()[axis]}, {s.strides()[axis]}};
-        auto lens  = s.lens();
-        lens[axis] = 1;
-        auto batch = shape{s.type(), lens, s.strides()};
-        auto& self = static_cast<const Derived&>(*this);
+        auto n = s.lens()[axis];
+        if(n == 0)
+            return result;
+        auto stride = static_cast<std::ptrdiff_t>(s.strides()[axis]);
+        auto last   = static_cast<std::ptrdiff_t>(n - 1) * stride;
+        auto lens   = s.lens();
+        lens[axis]  = 1;
+        auto batch  = shape{s.type(), lens, s.strides()};
+        auto& self  = static_cast<const Derived&>(*this);
         result.visit([&](auto output) {
-            using type = decltype(output);
-            par_for(batch.elements(), [&](auto i) {
-                auto* start = output.data() + batch.index(i);
-                type x{slice, start};
-                if(reverse)
-                {
-                    if(exclusive)
-                    {
-                        std::copy(++x.begin(), x.end(), x.begin());
-                        x.back() = 0;
-                    }
-                    std::partial_sum(std::make_reverse_iterator(x.end()),
-                                     std::make_reverse_iterator(x.begin()),
-                                     std::make_reverse_iterator(x.end()),
-                                     self.op());
-                }
-                else
-                {
-                    if(exclusive)
-                    {
-                        std::copy_backward(x.begin(), --x.end(), x.end());
-                        x.front() = 0;
-                    }
-                    std::partial_sum(x.begin(), x.end(), x.begin(), self.op());
-                }
-            });
+            auto offset = reverse ? last : 0;
+            prefix_scan_rows(
+                batch.elements(),
+                [&](std::size_t i) { return output.data() + batch.index(i) + offset; },
+                n,
+                reverse ? -stride : stride,
+                exclusive,
+                self.op());
         });
 
         return result;
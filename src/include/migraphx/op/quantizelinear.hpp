@@ -26,6 +26,7 @@
 
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/config.hpp>
+#include <migraphx/convert.hpp>
 #include <migraphx/argument.hpp>
 #include <migraphx/par_for.hpp>
 #include <migraphx/value.hpp>
@@ -92,9 +93,16 @@ struct quantizelinear
                 auto max_value   = std::numeric_limits<quant_type>::max();
                 par_for(output_shape.elements(), [&](auto i) {
                     double quantized = static_cast<double>(std::nearbyint(input[i] / scales[i])) +
-                                       static_cast<double>(zero_pts[i]);
-                    output[i] = std::max(static_cast<double>(min_value),
+                                       to_double(zero_pts[i]);
+
+                    quantized = std::max(static_cast<double>(min_value),
                                          std::min(static_cast<double>(max_value), quantized));
+                    // fp8 values are rounded through a table rather than bit by bit
+                    if constexpr(is_fp8<quant_type>{})
+                        output[i] =
+                            from_float_table<quant_type>::get()(static_cast<float>(quantized));
+                    else
+                        output[i] = quantized;
                 });
             });
         });
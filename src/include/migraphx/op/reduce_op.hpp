@@ -31,9 +31,14 @@
 #include <migraphx/tensor_view.hpp>
 #include <migraphx/shape_for_each.hpp>
 #include <migraphx/par_for.hpp>
+#include <migraphx/reduce_dims.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
 #include <migraphx/op/normalize_attribute.hpp>
+#include <migraphx/optional.hpp>
+#include <array>
+#include <numeric>
+#include <thread>
 #include <vector>
 
 namespace migraphx {
@@ -213,6 +218,141 @@ struct reduce_op : op_name<Derived>
             static_cast<const Derived&>(*this).output(batch_shape)(val);
     }
 
+    // Collapse the input into {outer, n, inner} dimensions where only the middle one is
+    // reduced. This is only possible for standard shapes where the reduced axes, once adjacent
+    // axes are merged with reduce_dims, form a single group.
+    static optional<std::array<std::size_t, 3>> slab_dims(const shape& input,
+                                                          const shape& output)
+    {
+        if(not input.standard() or not output.standard() or input.elements() == 0)
+            return nullopt;
+        auto shapes   = reduce_dims({input, output});
+        auto in_lens  = shapes[0].lens();
+        auto out_lens = shapes[1].lens();
+        if(in_lens.size() != out_lens.size())
+            return nullopt;
+        std::array<std::size_t, 3> dims = {1, 1, 1};
+        std::size_t group               = 0;
+        for(std::size_t i = 0; i < in_lens.size(); i++)
+        {
+            if(in_lens[i] == 1)
+                continue;
+            if(out_lens[i] != in_lens[i])
+            {
+                if(group == 2)
+                    return nullopt;
+                group = 1;
+            }
+            else if(group == 1)
+            {
+                group = 2;
+            }
+            dims[group] *= in_lens[i];
+        }
+        return dims;
+    }
+
+    // Horizontal reduction of n contiguous elements. Several independent accumulators are used
+    // so the loop can be vectorized without reassociating a single dependency chain.
+    template <class T>
+    accumulator_type<T> reduce_contiguous(const T* first, std::size_t n) const
+    {
+        using accumulator           = accumulator_type<T>;
+        constexpr std::size_t lanes = 8;
+        auto& self                  = static_cast<const Derived&>(*this);
+        auto op                     = self.op();
+        auto read                   = self.input();
+        accumulator init            = self.init();
+        std::array<accumulator, lanes> acc;
+        acc.fill(init);
+        std::size_t i = 0;
+        for(; i + lanes <= n; i += lanes)
+        {
+            for(std::size_t j = 0; j < lanes; j++)
+            {
+                accumulator x = first[i + j];
+                acc[j]        = op(accumulator{read(x)}, acc[j]);
+            }
+        }
+        for(; i < n; i++)
+        {
+            accumulator x = first[i];
+            acc[0]        = op(accumulator{read(x)}, acc[0]);
+        }
+        return std::accumulate(acc.begin() + 1, acc.end(), acc[0], op);
+    }
+
+    template <class T>
+    void reduce_slab(const T* input,
+                     T* output,
+                     const std::array<std::size_t, 3>& dims,
+                     const shape& batch_shape) const
+    {
+        using accumulator = accumulator_type<T>;
+        // Minimum number of input elements handled by one thread
+        constexpr std::size_t min_work = 4096;
+        auto& self                     = static_cast<const Derived&>(*this);
+        auto op                        = self.op();
+        auto read                      = self.input();
+        auto write                     = self.output(batch_shape);
+        auto outer                     = dims[0];
+        auto n                         = dims[1];
+        auto inner                     = dims[2];
+        if(inner == 1)
+        {
+            // With fewer rows than threads the rows themselves are split, and the partial
+            // results are combined afterwards
+            std::size_t nthreads = std::max(1u, std::thread::hardware_concurrency());
+            std::size_t nsplit   = 1;
+            if(outer < nthreads)
+                nsplit = std::max<std::size_t>(1, std::min(nthreads / outer, n / min_work));
+            if(nsplit == 1)
+            {
+                par_for(outer, std::max<std::size_t>(1, min_work / n), [&](auto i) {
+                    output[i] = write(this->reduce_contiguous(input + i * n, n));
+                });
+                return;
+            }
+            auto chunk = (n + nsplit - 1) / nsplit;
+            std::vector<accumulator> partial(outer * nsplit);
+            par_for(outer * nsplit, 1, [&](auto i) {
+                auto start = std::min(n, (i % nsplit) * chunk);
+                auto len   = std::min(chunk, n - start);
+                partial[i] = this->reduce_contiguous(input + (i / nsplit) * n + start, len);
+            });
+            for(std::size_t i = 0; i < outer; i++)
+            {
+                auto first = partial.begin() + i * nsplit;
+                output[i]  = write(std::accumulate(first + 1, first + nsplit, *first, op));
+            }
+            return;
+        }
+        // Accumulate whole rows of a tile of columns at a time, so the inner loop reads
+        // contiguous elements
+        constexpr std::size_t tile = 256;
+        auto ntiles                = (inner + tile - 1) / tile;
+        auto grain = std::max<std::size_t>(1, min_work / (n * std::min(tile, inner)));
+        par_for(outer * ntiles, grain, [&](auto i) {
+            auto start       = (i % ntiles) * tile;
+            auto width       = std::min(tile, inner - start);
+            const T* first   = input + (i / ntiles) * n * inner + start;
+            accumulator init = self.init();
+            std::array<accumulator, tile> acc;
+            std::fill_n(acc.begin(), width, init);
+            for(std::size_t r = 0; r < n; r++)
+            {
+                const T* row = first + r * inner;
+                for(std::size_t j = 0; j < width; j++)
+                {
+                    accumulator x = row[j];
+                    acc[j]        = op(accumulator{read(x)}, acc[j]);
+                }
+            }
+            T* out = output + (i / ntiles) * inner + start;
+            std::transform(acc.begin(), acc.begin() + width, out, write);
+        });
+    }
+
     argument reduce(const shape& computed_shape,
                     const std::vector<int64_t>& reduce_axes,
                     argument& data_arg) const
@@ -223,7 +363,13 @@ struct reduce_op : op_name<Derived>
         shape batch_shape{computed_shape.type(), batch_lens};
         argument result{computed_shape};
 
+        auto dims = slab_dims(data_arg.get_shape(), computed_shape);
         visit_all(result, data_arg)([&](auto output, auto input) {
+            if(has_value(dims))
+            {
+                this->reduce_slab(input.data(), output.data(), *dims, batch_shape);
+                return;
+            }
             par_for(computed_shape.elements(), [&](auto i) {
                 auto out_idx = computed_shape.multi(i);
                 this->reduce(input, batch_shape, reduce_axes, out_idx, output);
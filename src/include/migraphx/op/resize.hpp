@@ -31,8 +31,12 @@
 #include <migraphx/streamutils.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/shape_for_each.hpp>
+#include <migraphx/functional.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/ranges.hpp>
 #include <migraphx/config.hpp>
 #include <cmath>
+#include <numeric>
 #include <utility>
 
 namespace migraphx {
@@ -41,7 +45,9 @@ namespace op {
 
 /**
  * The Resize operation mirrors the Onnx Resize operation with some differences.
- * Currently, only Nearest mode is supported.  "Axes" and "ROI" attributes not recognized.
+ * Nearest, linear and cubic modes are supported.  "Axes" and "ROI" attributes not recognized.
+ * Linear and cubic modes are separable, so they are computed one axis at a time using a table
+ * of input indices and weights for each output coordinate of that axis.
  *
  * Accepts either one or two runtime inputs.
  * Input 0 - data to be resized
@@ -124,15 +130,37 @@ struct resize
         return idx_ops.at(s_mode);
     }
 
+    // Input indices and weights used to compute each output coordinate along one axis
+    struct interpolation_table
+    {
+        std::size_t taps = 0;
+        std::vector<std::size_t> indices;
+        std::vector<double> weights;
+
+        bool is_identity() const
+        {
+            for(std::size_t i = 0; i < indices.size(); i++)
+            {
+                auto j = i / taps;
+                if(weights[i] != 0 and (indices[i] != j or weights[i] != 1))
+                    return false;
+            }
+            return true;
+        }
+    };
+
     std::vector<float> scales;
     std::vector<size_t> sizes;
     // what integer rounding rule to use with Nearest mode.
     std::string nearest_mode{"floor"};
     // Resizing modes.  1: nearest 2: bilinear/linear 3: cubic
-    // Only "nearest" currently supported.
     std::string mode{"nearest"};
     // What floating-point conversion rule to use (any resizing mode)
     std::string coordinate_transformation_mode;
+    // Coefficient used in cubic mode
+    float cubic_coeff_a = -0.75f;
+    // Set the weights of samples outside of the input to zero in linear and cubic modes
+    bool exclude_outside = false;
 
     std::string name() const { return "resize"; }
 
@@ -143,15 +171,17 @@ struct resize
                     f(self.sizes, "sizes"),
                     f(self.nearest_mode, "nearest_mode"),
                     f(self.mode, "mode"),
-                    f(self.coordinate_transformation_mode, "coordinate_transformation_mode"));
+                    f(self.coordinate_transformation_mode, "coordinate_transformation_mode"),
+                    f(self.cubic_coeff_a, "cubic_coeff_a"),
+                    f(self.exclude_outside, "exclude_outside"));
     }
 
     shape compute_shape(std::vector<shape> inputs) const
     {
         check_shapes{inputs, *this, true}.has(1, 2);
 
-        if(mode != "nearest")
-            MIGRAPHX_THROW("RESIZE: Only Nearest mode is supported");
+        if(not contains({"nearest", "linear", "cubic"}, mode))
+            MIGRAPHX_THROW("RESIZE: mode " + mode + " not supported!");
 
         // Inputs are X, sizes or scale, ROI and axes not supported.
         if(inputs.size() == 1)
@@ -209,7 +239,61 @@ struct resize
         }
     }
 
-    argument compute(const migraphx::shape&, std::vector<argument> args) const
+    interpolation_table
+    make_interpolation_table(std::size_t in_len, std::size_t out_len, double scale) const
+    {
+        auto idx_op = get_original_idx_op(coordinate_transformation_mode);
+        interpolation_table table;
+        table.taps = mode == "cubic" ? 4 : 2;
+        table.indices.resize(out_len * table.taps);
+        table.weights.resize(out_len * table.taps);
+        double a = cubic_coeff_a;
+        for(std::size_t i = 0; i < out_len; i++)
+        {
+            double x     = idx_op(in_len, out_len, i, scale);
+            double start = std::floor(x);
+            double t     = x - start;
+            std::array<double, 4> w{};
+            if(mode == "cubic")
+            {
+                start -= 1;
+                w[0] = ((a * (t + 1) - 5 * a) * (t + 1) + 8 * a) * (t + 1) - 4 * a;
+                w[1] = ((a + 2) * t - (a + 3)) * t * t + 1;
+                w[2] = ((a + 2) * (1 - t) - (a + 3)) * (1 - t) * (1 - t) + 1;
+                w[3] = ((a * (2 - t) - 5 * a) * (2 - t) + 8 * a) * (2 - t) - 4 * a;
+            }
+            else
+            {
+                w[0] = 1 - t;
+                w[1] = t;
+            }
+            double total = 0;
+            for(std::size_t k = 0; k < table.taps; k++)
+            {
+                auto j      = static_cast<std::ptrdiff_t>(start) + static_cast<std::ptrdiff_t>(k);
+                auto inside = j >= 0 and j < static_cast<std::ptrdiff_t>(in_len);
+                if(not inside and exclude_outside)
+                    w[k] = 0;
+                // Samples outside of the input use the nearest edge
+                j = std::max<std::ptrdiff_t>(0, std::min<std::ptrdiff_t>(j, in_len - 1));
+                table.indices[i * table.taps + k] = j;
+                table.weights[i * table.taps + k] = w[k];
+                total += w[k];
+            }
+            if(exclude_outside and total != 0)
+            {
+                std::transform(table.weights.begin() + i * table.taps,
+                               table.weights.begin() + (i + 1) * table.taps,
+                               table.weights.begin() + i * table.taps,
+                               [&](auto y) { return y / total; });
+            }
+        }
+        return table;
+    }
+
+    // Compute the output lens and the scales of each axis
+    std::pair<std::vector<std::size_t>, std::vector<float>>
+    compute_sizes(const std::vector<argument>& args) const
     {
         auto in_lens = args[0].get_shape().lens();
         std::vector<size_t> out_lens(in_lens.size());
@@ -283,25 +367,106 @@ struct resize
                 }
             });
         }
+        return {out_lens, vec_scale};
+    }
 
-        shape output_shape = {args[0].get_shape().type(), out_lens};
-        argument result{output_shape};
-        auto nearest_op = get_nearest_op(nearest_mode);
-        auto idx_op     = get_original_idx_op(coordinate_transformation_mode);
+    // Resize the input into the standard shaped result. The par_for function is used to run the
+    // loop over the output rows of each axis in parallel.
+    template <class ParFor>
+    void resize_into(argument result,
+                     const argument& input,
+                     const std::vector<std::size_t>& out_lens,
+                     const std::vector<float>& vec_scale,
+                     ParFor par) const
+    {
+        auto in_lens = input.get_shape().lens();
+        if(mode == "nearest")
+        {
+            auto nearest_op = get_nearest_op(nearest_mode);
+            auto idx_op     = get_original_idx_op(coordinate_transformation_mode);
 
-        // Populate each element in output by selecting "nearest" item in input.
-        visit_all(result, args[0])([&](auto output, auto data) {
-            migraphx::shape out_comp_shape{data.get_shape().type(), out_lens};
-            shape_for_each(out_comp_shape, [&](const auto& out_idx_v, size_t out_idx) {
-                std::vector<size_t> in_idx(out_idx_v.size());
-                for(auto ii = 0; ii < out_idx_v.size(); ++ii)
-                {
-                    auto idx_val = idx_op(in_lens[ii], out_lens[ii], out_idx_v[ii], vec_scale[ii]);
-                    in_idx[ii]   = nearest_op(in_lens[ii], idx_val);
-                }
-                output[out_idx] = data(in_idx.begin(), in_idx.end());
+            // Populate each element in output by selecting "nearest" item in input.
+            visit_all(result, input)([&](auto output, auto data) {
+                migraphx::shape out_comp_shape{data.get_shape().type(), out_lens};
+                shape_for_each(out_comp_shape, [&](const auto& out_idx_v, size_t out_idx) {
+                    std::vector<size_t> in_idx(out_idx_v.size());
+                    for(auto ii = 0; ii < out_idx_v.size(); ++ii)
+                    {
+                        auto idx_val =
+                            idx_op(in_lens[ii], out_lens[ii], out_idx_v[ii], vec_scale[ii]);
+                        in_idx[ii] = nearest_op(in_lens[ii], idx_val);
+                    }
+                    output[out_idx] = data(in_idx.begin(), in_idx.end());
+                });
+            });
+            return;
+        }
+
+        std::vector<interpolation_table> tables;
+        std::vector<std::size_t> axes;
+        for(std::size_t axis = 0; axis < in_lens.size(); axis++)
+        {
+            tables.push_back(
+                make_interpolation_table(in_lens[axis], out_lens[axis], vec_scale[axis]));
+            if(in_lens[axis] != out_lens[axis] or not tables.back().is_identity())
+                axes.push_back(axis);
+        }
+        // Shrink the tensor as early as possible to reduce the work done for the other axes
+        std::stable_sort(axes.begin(), axes.end(), by(std::less<>{}, [&](auto axis) {
+                             return double(out_lens[axis]) / in_lens[axis];
+                         }));
+
+        visit_all(result, input)([&](auto output, auto data) {
+            using type       = typename decltype(output)::value_type;
+            using accumulate = std::conditional_t<std::is_same<type, double>{}, double, float>;
+            std::vector<accumulate> current(data.begin(), data.end());
+            std::vector<accumulate> next;
+            auto lens = in_lens;
+            for(auto axis : axes)
+            {
+                const auto& table = tables[axis];
+                auto outer        = std::accumulate(
+                    lens.begin(), lens.begin() + axis, std::size_t{1}, std::multiplies<>{});
+                auto inner = std::accumulate(
+                    lens.begin() + axis + 1, lens.end(), std::size_t{1}, std::multiplies<>{});
+                auto in_len  = lens[axis];
+                auto out_len = out_lens[axis];
+                next.assign(outer * out_len * inner, 0);
+                par(outer * out_len, [&](std::size_t i) {
+                    auto o  = i / out_len;
+                    auto j  = i % out_len;
+                    auto* y = next.data() + i * inner;
+                    for(std::size_t k = 0; k < table.taps; k++)
+                    {
+                        auto w = static_cast<accumulate>(table.weights[j * table.taps + k]);
+                        if(w == 0)
+                            continue;
+                        auto offset   = (o * in_len + table.indices[j * table.taps + k]) * inner;
+                        const auto* x = current.data() + offset;
+                        for(std::size_t e = 0; e < inner; e++)
+                            y[e] += w * x[e];
+                    }
+                });
+                lens[axis] = out_len;
+                std::swap(current, next);
+            }
+            std::transform(current.begin(), current.end(), output.begin(), [](auto x) {
+                if constexpr(std::is_integral<type>{})
+                    return static_cast<type>(std::nearbyint(x));
+                else
+                    return static_cast<type>(x);
             });
         });
+    }
+
+    argument compute(const migraphx::shape&, std::vector<argument> args) const
+    {
+        auto [out_lens, vec_scale] = compute_sizes(args);
+        shape output_shape         = {args[0].get_shape().type(), out_lens};
+        argument result{output_shape};
+        resize_into(result, args[0], out_lens, vec_scale, [](std::size_t n, auto f) {
+            par_for(n, f);
+        });
         return result;
     }
 };
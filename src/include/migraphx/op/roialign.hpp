@@ -29,10 +29,9 @@
 #include <migraphx/op/common.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/argument.hpp>
+#include <migraphx/copy_layout.hpp>
 #include <migraphx/par_for.hpp>
-#include <migraphx/dfor.hpp>
 #include <migraphx/ranges.hpp>
-#include <migraphx/shape_for_each.hpp>
 #include <array>
 #include <cmath>
 #include <numeric>
@@ -106,55 +105,90 @@ struct roialign
         std::array<float, 4> w = {0.0f, 0.0f, 0.0f, 0.0f};
     };
 
-    auto calc_pos_weight(const std::array<std::size_t, 2>& dims,
-                         const shape& comp_s,
-                         const std::array<float, 2>& roi_start,
-                         const std::array<float, 2>& bin_size,
-                         const std::array<std::size_t, 2>& bin_grid_size) const
+    struct axis_weight
     {
-        std::vector<pos_weight> results(bin_grid_size[0] * bin_grid_size[1] * output_height *
-                                        output_width);
-        shape_for_each(comp_s, [&](const auto& idx_v, size_t index) {
-            std::array<std::size_t, 2> p = {idx_v[0], idx_v[1]};
-            std::array<std::size_t, 2> i = {idx_v[2], idx_v[3]};
-
-            std::array<float, 2> xy{};
-            std::array<int64_t, 2> low{};
-            std::array<int64_t, 2> high{};
-            for(auto ii : range(p.size()))
+        std::size_t low  = 0;
+        std::size_t high = 0;
+        // distance of the sample from low
+        float l    = 0.0f;
+        bool valid = false;
+    };
+
+    // Sample positions along one axis for every output bin and every sample inside the bin
+    std::vector<axis_weight> calc_axis_weight(std::size_t dim,
+                                              std::size_t out_dim,
+                                              float roi_start,
+                                              float bin_size,
+                                              std::size_t bin_grid_size) const
+    {
+        std::vector<axis_weight> results(out_dim * bin_grid_size);
+        for(std::size_t p = 0; p < out_dim; p++)
+        {
+            for(std::size_t i = 0; i < bin_grid_size; i++)
             {
-                xy[ii] = roi_start[ii] + p[ii] * bin_size[ii] +
-                         (i[ii] + .5f) * bin_size[ii] / bin_grid_size[ii];
-                xy[ii] = (coord_trans_mode == "half_pixel") ? (xy[ii] - 0.5f) : xy[ii];
-                if(xy[ii] < -1.0 or xy[ii] > dims[ii])
+                auto& r  = results[p * bin_grid_size + i];
+                float xy = roi_start + p * bin_size + (i + .5f) * bin_size / bin_grid_size;
+                xy       = (coord_trans_mode == "half_pixel") ? (xy - 0.5f) : xy;
+                if(xy < -1.0 or xy > dim)
+                    continue;
+
+                xy           = std::max(xy, 0.0f);
+                int64_t low  = xy;
+                int64_t high = low + 1;
+                if(low >= dim - 1)
                 {
-                    results[index] = pos_weight{};
-                    return;
+                    xy = high = low = dim - 1;
                 }
+                r.low   = low;
+                r.high  = high;
+                r.l     = xy - low;
+                r.valid = true;
+            }
+        }
+        return results;
+    }
 
-                xy[ii]   = std::max(xy[ii], 0.0f);
-                low[ii]  = xy[ii];
-                high[ii] = low[ii] + 1;
-                if(low[ii] >= dims[ii] - 1)
+    // The bilinear positions and weights are separable, so they are computed per axis and then
+    // combined into a table ordered by output bin and then by sample, which is shared by all
+    // the channels of the roi
+    std::vector<pos_weight> calc_pos_weight(const std::array<std::size_t, 2>& dims,
+                                            const std::array<std::size_t, 2>& out_dims,
+                                            const std::array<float, 2>& roi_start,
+                                            const std::array<float, 2>& bin_size,
+                                            const std::array<std::size_t, 2>& bin_grid_size) const
+    {
+        auto ys =
+            calc_axis_weight(dims[0], out_dims[0], roi_start[0], bin_size[0], bin_grid_size[0]);
+        auto xs =
+            calc_axis_weight(dims[1], out_dims[1], roi_start[1], bin_size[1], bin_grid_size[1]);
+        std::vector<pos_weight> results;
+        results.reserve(ys.size() * xs.size());
+        for(std::size_t ph = 0; ph < out_dims[0]; ph++)
+        {
+            for(std::size_t pw = 0; pw < out_dims[1]; pw++)
+            {
+                for(std::size_t iy = 0; iy < bin_grid_size[0]; iy++)
                 {
-                    xy[ii] = high[ii] = low[ii] = dims[ii] - 1;
+                    const auto& y = ys[ph * bin_grid_size[0] + iy];
+                    for(std::size_t ix = 0; ix < bin_grid_size[1]; ix++)
+                    {
+                        const auto& x = xs[pw * bin_grid_size[1] + ix];
+                        results.emplace_back();
+                        if(not y.valid or not x.valid)
+                            continue;
+                        auto& r = results.back();
+                        r.pos   = {y.low * dims[1] + x.low,
+                                   y.low * dims[1] + x.high,
+                                   y.high * dims[1] + x.low,
+                                   y.high * dims[1] + x.high};
+
+                        float hy = 1.0f - y.l;
+                        float hx = 1.0f - x.l;
+                        r.w      = {hy * hx, hy * x.l, y.l * hx, y.l * x.l};
+                    }
                 }
             }
-
-            results[index].pos = {low[0] * dims[1] + low[1],
-                                  low[0] * dims[1] + high[1],
-                                  high[0] * dims[1] + low[1],
-                                  high[0] * dims[1] + high[1]};
-
-            float ly = xy[0] - low[0];
-            float lx = xy[1] - low[1];
-            float hy = 1.0f - ly;
-            float hx = 1.0f - lx;
-
-            // save weights and indeces
-            results[index].w = {hy * hx, hy * lx, ly * hx, ly * lx};
-        });
-
+        }
         return results;
     }
 
@@ -176,36 +210,34 @@ struct roialign
         double final(double x, std::size_t y) { return (y == 0) ? 0.0 : (x / y); }
     };
 
-    template <class T, class Op>
-    std::tuple<double, int64_t> calc_pooling(const T& data,
-                                             const std::array<std::size_t, 2>& bin_grid_size,
-                                             const std::vector<pos_weight>& pos_weights,
-                                             int64_t index,
-                                             Op op) const
+    // Pool one channel of a roi, where data points to the input plane of the channel and
+    // output to the output plane
+    template <class T, class U, class Op>
+    static void calc_pooling(const T* data,
+                             U* output,
+                             std::size_t bins,
+                             std::size_t count,
+                             const std::vector<pos_weight>& pos_weights,
+                             Op op)
     {
-        double output_val   = op.init();
-        const int64_t count = bin_grid_size[0] * bin_grid_size[1];
-        dfor(bin_grid_size[0], bin_grid_size[1])([&](auto, auto) {
-            const auto& pc = pos_weights[index];
-            std::array<double, 4> wv;
-            std::transform(
-                pc.w.begin(), pc.w.end(), pc.pos.begin(), wv.begin(), [&](auto w, auto pos) {
-                    return *(data + pos) * w;
-                });
-            output_val = std::accumulate(wv.begin(), wv.end(), output_val, op);
-            index += 1;
-        });
-
-        output_val = op.final(output_val, count);
-
-        return {output_val, index};
+        const auto* pc = pos_weights.data();
+        for(std::size_t b = 0; b < bins; b++)
+        {
+            double output_val = op.init();
+            for(std::size_t k = 0; k < count; k++, pc++)
+            {
+                for(std::size_t j = 0; j < 4; j++)
+                    output_val = op(output_val, data[pc->pos[j]] * pc->w[j]);
+            }
+            output[b] = op.final(output_val, count);
+        }
     }
 
     argument compute(const shape& output_shape, std::vector<argument> args) const
     {
         argument result{output_shape};
         const auto& out_lens = output_shape.lens();
-        int64_t n_rois       = out_lens[0];
+        std::size_t n_rois   = out_lens[0];
         std::size_t channels = out_lens[1];
         // output dims of height and width, in all 2-dim arrays, the first dim
         // is for height and second dim is for width
@@ -215,11 +247,20 @@ struct roialign
         std::array<std::size_t, 2> in_dims = {x_lens[2], x_lens[3]};
         auto roi_s                         = args.at(1).get_shape();
 
-        visit_all(result, args.at(0), args.at(1))([&](auto output, auto x, auto roi) {
-            const auto* batch_indices = args.at(2).cast<int64_t>();
+        // The channel planes are read directly, so the input needs to be standard
+        auto x_arg = args.at(0);
+        if(not x_arg.get_shape().standard())
+        {
+            x_arg = argument{shape{x_arg.get_shape().type(), x_lens}};
+            visit_all(x_arg, args.at(0))([](auto out, auto in) { copy_layout(out, in); });
+        }
+
+        // Positions and weights of the samples for each roi
+        std::vector<std::vector<pos_weight>> pre_calc(n_rois);
+        // Number of samples in each bin of each roi
+        std::vector<std::size_t> counts(n_rois);
+        args.at(1).visit([&](auto roi) {
             par_for(n_rois, [&](auto n) {
-                const auto bottom_data   = x.begin();
-                const auto roi_batch_ind = batch_indices[n];
                 // Do not using rounding; this implementation detail is critical
                 std::array<float, 2> roi_starts = {
                     static_cast<float>(roi[roi_s.index({n, 1})] * spatial_scale),
@@ -244,40 +285,26 @@ struct roialign
                                             : std::ceil(roi_size[ii] / out_dims[ii]);
                 }
 
-                // we want to precalculate indices and weights shared by all channels,
-                // this is the key point of optimization
-                std::vector<std::size_t> comp_lens = {
-                    out_dims[0], out_dims[1], bin_grid_size[0], bin_grid_size[1]};
-                shape comp_s{shape::float_type, comp_lens};
-                auto pre_calc =
-                    this->calc_pos_weight(in_dims, comp_s, roi_starts, bin_size, bin_grid_size);
-
-                std::vector<std::size_t> comp_lens1 = {channels, out_dims[0], out_dims[1]};
-                shape comp_s1{migraphx::shape::float_type, comp_lens1};
-                std::vector<int64_t> vec_index(channels, 0);
-                shape_for_each(comp_s1, [&](const auto& idx) {
-                    auto c  = idx[0];
-                    auto ph = idx[1];
-                    auto pw = idx[2];
-
-                    const auto offset_bottom_data =
-                        bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) *
-                                                           in_dims[0] * in_dims[1]);
-                    double output_val;
-                    std::tie(output_val, vec_index[c]) =
-                        (mode == migraphx::op::pooling_mode::average)
-                            ? this->calc_pooling(offset_bottom_data,
-                                                 bin_grid_size,
-                                                 pre_calc,
-                                                 vec_index[c],
-                                                 avg_pool{})
-                            : this->calc_pooling(offset_bottom_data,
-                                                 bin_grid_size,
-                                                 pre_calc,
-                                                 vec_index[c],
-                                                 max_pool{});
-                    output(n, c, ph, pw) = output_val;
-                });
+                counts[n] = bin_grid_size[0] * bin_grid_size[1];
+                pre_calc[n] =
+                    this->calc_pos_weight(in_dims, out_dims, roi_starts, bin_size, bin_grid_size);
+            });
+        });
+
+        const auto* batch_indices = args.at(2).cast<int64_t>();
+        std::size_t in_plane      = in_dims[0] * in_dims[1];
+        std::size_t out_plane     = out_dims[0] * out_dims[1];
+        visit_all(result, x_arg)([&](auto output, auto x) {
+            // Each channel of each roi is pooled independently with the table of its roi
+            par_for(n_rois * channels, [&](auto i) {
+                auto n          = i / channels;
+                auto c          = i % channels;
+                const auto* src = x.data() + (batch_indices[n] * channels + c) * in_plane;
+                auto* dst       = output.data() + i * out_plane;
+                if(mode == migraphx::op::pooling_mode::average)
+                    calc_pooling(src, dst, out_plane, counts[n], pre_calc[n], avg_pool{});
+                else
+                    calc_pooling(src, dst, out_plane, counts[n], pre_calc[n], max_pool{});
             });
         });
 
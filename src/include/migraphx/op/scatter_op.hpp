@@ -26,6 +26,7 @@
 
 #include <array>
 #include <migraphx/check_shapes.hpp>
+#include <migraphx/copy_layout.hpp>
 #include <migraphx/shape_for_each.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
@@ -77,7 +78,7 @@ struct scatter_op : op_name<Derived>
         // cast all arguments as correct type
         visit_all(result, args[0], args[2])([&](auto output, auto data, auto update) {
             // copy all of data to output
-            std::copy(data.begin(), data.end(), output.begin());
+            copy_layout(output, data);
             args[1].visit([&](auto indices) {
                 auto ind_s = indices.get_shape();
                 // iterate through items in shape
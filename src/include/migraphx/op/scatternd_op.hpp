@@ -27,8 +27,11 @@
 #include <migraphx/op/name.hpp>
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/argument.hpp>
+#include <migraphx/copy_layout.hpp>
 #include <migraphx/par_for.hpp>
 #include <migraphx/ranges.hpp>
+#include <functional>
+#include <numeric>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -115,7 +118,7 @@ struct scatternd_op : op_name<Derived>
         argument result{dyn_out.computed_shape};
         auto& self = static_cast<const Derived&>(*this);
         visit_all(result, args[0], args[2])([&](auto output, auto data, auto updates) {
-            std::copy(data.begin(), data.end(), output.begin());
+            copy_layout(output, data);
             args[1].visit([&](auto indices) {
                 auto updates_shape = updates.get_shape();
                 auto updates_std   = shape{updates_shape.type(), updates_shape.lens()};
@@ -123,6 +126,49 @@ struct scatternd_op : op_name<Derived>
                 auto k             = indices_shape.lens().back();
                 auto q             = indices_shape.ndim();
                 auto r             = dyn_out.computed_shape.ndim();
+                if(dyn_out.computed_shape.standard() and updates_shape.standard() and
+                   indices_shape.standard())
+                {
+                    // Every index tuple selects a contiguous slab of the output, which is
+                    // updated from the next contiguous slab of the updates. The tuples are
+                    // applied in order since they can repeat.
+                    const auto& out_lens    = dyn_out.computed_shape.lens();
+                    const auto& out_strides = dyn_out.computed_shape.strides();
+                    const auto& ind_lens    = indices_shape.lens();
+
+                    std::size_t slab = std::accumulate(out_lens.begin() + k,
+                                                       out_lens.end(),
+                                                       std::size_t{1},
+                                                       std::multiplies<std::size_t>());
+                    std::size_t n    = std::accumulate(ind_lens.begin(),
+                                                       ind_lens.end() - 1,
+                                                       std::size_t{1},
+                                                       std::multiplies<std::size_t>());
+                    auto* out        = output.data();
+                    const auto* upd  = updates.data();
+                    const auto* idx  = indices.data();
+                    for(std::size_t i = 0; i < n; i++)
+                    {
+                        std::size_t offset = 0;
+                        for(std::size_t j = 0; j < k; j++)
+                        {
+                            int64_t index = idx[i * k + j];
+                            auto dim      = static_cast<int64_t>(out_lens[j]);
+                            if(index < -dim or index >= dim)
+                                MIGRAPHX_THROW("ScatterND: index " + std::to_string(index) +
+                                               " is out of bounds for dim of len " +
+                                               std::to_string(dim));
+                            if(index < 0)
+                                index += dim;
+                            offset += index * out_strides[j];
+                        }
+                        auto* dst       = out + offset;
+                        const auto* src = upd + i * slab;
+                        for(std::size_t j = 0; j < slab; j++)
+                            self.reduction()(dst[j], src[j]);
+                    }
+                    return;
+                }
                 for(auto i = 0u; i < updates_shape.elements(); ++i)
                 {
                     auto updates_idx = updates_std.multi(i);
@@ -0,0 +1,166 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_OPERATORS_TENSOR_SCATTER_HPP
+#define MIGRAPHX_GUARD_OPERATORS_TENSOR_SCATTER_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/copy_layout.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/value.hpp>
+#include <migraphx/op/normalize_attribute.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * tensor_scatter(cache, update, [write_indices])
+ * Write update into cache along axis, starting for batch b at write_indices[b] (or at 0 when
+ * there are no indices). In linear mode the update has to fit before the end of the axis, and
+ * in circular mode the positions wrap around it. The cache is copied into the output and the
+ * update is written there. When the cache is a @state, mark_state_writes sets inplace so the
+ * state is updated in place instead, which appends to a kv-cache without copying it. An inplace
+ * write can have more inputs after the write indices, which are the instructions that have to
+ * read the state before it is written.
+ */
+struct tensor_scatter
+{
+    int64_t axis     = -2;
+    std::string mode = "linear";
+    bool inplace     = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.axis, "axis"), f(self.mode, "mode"), f(self.inplace, "inplace"));
+    }
+
+    value attributes() const
+    {
+        value normalize;
+        normalize["axis"] = value::array{normalize_attribute::include_min};
+        return {{"normalize_axes", normalize}, {"side_effects", inplace}};
+    }
+
+    std::string name() const { return "tensor_scatter"; }
+
+    shape normalize_compute_shape(std::vector<shape> inputs) const
+    {
+        // The inputs after the write indices of an inplace write are only dependencies
+        if(inplace and inputs.size() > 3)
+            inputs.resize(3);
+        check_shapes{inputs, *this}.has(2, 3);
+        check_shapes{inputs.begin(), inputs.begin() + 2, *this}.same_type().same_ndims();
+        if(not contains({"linear", "circular"}, mode))
+            MIGRAPHX_THROW("TENSOR_SCATTER: unknown mode: " + mode);
+        if(axis == 0)
+            MIGRAPHX_THROW("TENSOR_SCATTER: axis can not be the batch axis");
+        const auto& cache  = inputs[0].lens();
+        const auto& update = inputs[1].lens();
+        auto a             = static_cast<std::size_t>(axis);
+        for(std::size_t d = 0; d < cache.size(); d++)
+        {
+            bool fits = d == a ? update[d] <= cache[d] : update[d] == cache[d];
+            if(not fits)
+                MIGRAPHX_THROW("TENSOR_SCATTER: update does not fit into the cache");
+        }
+        if(inputs.size() == 3 and inputs[2].lens() != std::vector<std::size_t>{cache.front()})
+            MIGRAPHX_THROW("TENSOR_SCATTER: write_indices must have one index per batch");
+        if(inplace)
+            return inputs[0];
+        return {inputs[0].type(), inputs[0].lens()};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result = args[0];
+        if(not inplace)
+        {
+            result = argument{output_shape};
+            visit_all(result, args[0])(
+                [&](auto output, auto cache) { copy_layout(output, cache); });
+        }
+        const auto& cs   = result.get_shape();
+        const auto& us   = args[1].get_shape();
+        const auto& lens = us.lens();
+        auto len         = static_cast<std::int64_t>(cs.lens()[axis]);
+        std::vector<std::int64_t> offsets(lens.front(), 0);
+        if(args.size() >= 3)
+        {
+            args[2].visit([&](auto indices) {
+                std::transform(indices.begin(), indices.end(), offsets.begin(), [](auto i) {
+                    return static_cast<std::int64_t>(i);
+                });
+            });
+        }
+        if(mode == "linear")
+        {
+            for(auto offset : offsets)
+            {
+                if(offset < 0 or offset + static_cast<std::int64_t>(lens[axis]) > len)
+                    MIGRAPHX_THROW("TENSOR_SCATTER: write index " + std::to_string(offset) +
+                                   " is out of bounds");
+            }
+        }
+        auto position = [&](std::size_t b, std::size_t i) {
+            auto pos = (offsets[b] + static_cast<std::int64_t>(i)) % len;
+            return static_cast<std::size_t>(pos < 0 ? pos + len : pos);
+        };
+        // The elements after the axis are copied as one run when both sides are packed
+        bool packed       = cs.standard() and us.standard();
+        std::size_t inner = packed ? std::accumulate(lens.begin() + axis + 1,
+                                                     lens.end(),
+                                                     std::size_t{1},
+                                                     std::multiplies<>{})
+                                   : 1;
+        visit_all(result, args[1])([&](auto cache, auto update) {
+            par_for(us.elements() / inner, [&](std::size_t i) {
+                std::vector<std::size_t> idx(lens.size());
+                us.multi_copy(i * inner, idx.data(), idx.data() + idx.size());
+                auto src  = us.index(idx);
+                idx[axis] = position(idx.front(), idx[axis]);
+                auto dst  = cs.index(idx);
+                std::copy(update.data() + src, update.data() + src + inner, cache.data() + dst);
+            });
+        });
+        return result;
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>&) const { return inplace ? 0 : -1; }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
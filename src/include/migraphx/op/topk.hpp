@@ -32,6 +32,8 @@
 #include <migraphx/par_for.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/value.hpp>
+#include <numeric>
+#include <thread>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -72,39 +74,34 @@ struct topk
         return shape({s_val, s_ind});
     }
 
+    // Move the first n elements in order to the front of the buffer
     template <class T, class Compare>
-    struct heap_vector
+    static void select(std::vector<T>& elements, std::size_t n, Compare compare)
     {
-        std::vector<T> data;
-        Compare compare;
-
-        heap_vector(const std::vector<T>& val, Compare comp) : data(val), compare(std::move(comp))
-        {
-            std::make_heap(data.begin(), data.end(), compare);
-        }
-
-        void try_push(T val)
+        // Below this size the best elements are kept in a small sorted buffer
+        constexpr std::size_t small_k = 16;
+        auto first                    = elements.begin();
+        auto last                     = first + n;
+        if(n == 0)
+            return;
+        if(n <= small_k)
         {
-            if(not compare(val, data.front()))
-                return;
-
-            std::pop_heap(data.begin(), data.end(), compare);
-            data.back() = val;
-            std::push_heap(data.begin(), data.end(), compare);
+            std::sort(first, last, compare);
+            for(auto it = last; it != elements.end(); ++it)
+            {
+                if(not compare(*it, *(last - 1)))
+                    continue;
+                auto x   = *it;
+                auto pos = std::upper_bound(first, last, x, compare);
+                std::move_backward(pos, last - 1, last);
+                *pos = x;
+            }
         }
-
-        std::vector<T> sort()
+        else
         {
-            auto sorted_data = data;
-            std::sort_heap(sorted_data.begin(), sorted_data.end(), compare);
-            return sorted_data;
+            std::nth_element(first, last, elements.end(), compare);
+            std::sort(first, last, compare);
         }
-    };
-
-    template <class T, class Compare>
-    heap_vector<T, Compare> make_heap(std::vector<T> val, Compare compare) const
-    {
-        return {std::move(val), std::move(compare)};
     }
 
     argument compute(const shape& output_shape, std::vector<argument> args) const
@@ -112,45 +109,44 @@ struct topk
         auto vec_ss = output_shape.sub_shapes();
         argument res_val{vec_ss.front()};
         argument res_ind{vec_ss.back()};
-        auto in_s      = args.front().get_shape();
-        auto out_s     = vec_ss.front();
-        auto comp_lens = in_s.lens();
-        auto axis_dim  = comp_lens[axis];
-
-        // compute shape
-        comp_lens[axis] = 1;
-        shape comp_s{in_s.type(), comp_lens};
+        auto in_lens  = args.front().get_shape().lens();
+        auto axis_dim = in_lens[axis];
+        auto n        = std::min<std::size_t>(k, axis_dim);
+        auto outer    = std::accumulate(
+            in_lens.begin(), in_lens.begin() + axis, std::size_t{1}, std::multiplies<>{});
+        auto inner = std::accumulate(
+            in_lens.begin() + axis + 1, in_lens.end(), std::size_t{1}, std::multiplies<>{});
+        auto nslices = outer * inner;
+
         visit_all(res_val, args.front())([&](auto out_val, auto input) {
-            auto* out_ind = res_ind.cast<int64_t>();
-            par_for(comp_s.elements(), [&](auto i) {
-                auto idx = comp_s.multi(i);
-                std::vector<std::size_t> indices(k);
-                std::iota(indices.begin(), indices.end(), 0);
-
-                auto comp = [&](auto i1, auto i2) {
-                    auto idx1  = idx;
-                    auto idx2  = idx;
-                    idx1[axis] = i1;
-                    idx2[axis] = i2;
-                    return this->largest
-                               ? std::greater<>{}(input[in_s.index(idx1)], input[in_s.index(idx2)])
-                               : std::less<>{}(input[in_s.index(idx1)], input[in_s.index(idx2)]);
-                };
-
-                auto hp = this->make_heap(indices, comp);
-                for(std::size_t ii = indices.size(); ii < axis_dim; ++ii)
-                {
-                    hp.try_push(ii);
-                }
-                auto sorted_indices = hp.sort();
-                auto out_idx        = idx;
-                auto in_idx         = idx;
-                for(auto j : range(sorted_indices.size()))
+            using type = typename decltype(input)::value_type;
+            using item = std::pair<type, int64_t>;
+            // Equal values are ordered by their index, so ties are deterministic
+            auto compare = [&](const item& x, const item& y) {
+                if(x.first < y.first or y.first < x.first)
+                    return largest ? y.first < x.first : x.first < y.first;
+                return x.second < y.second;
+            };
+            auto* out_ind        = res_ind.cast<int64_t>();
+            std::size_t nthreads = std::max(1u, std::thread::hardware_concurrency());
+            std::size_t ntasks   = std::max<std::size_t>(1, std::min(nslices, nthreads));
+            std::size_t grain    = (nslices + ntasks - 1) / ntasks;
+            par_for(ntasks, 1, [&](auto task) {
+                // Scratch buffer reused for all the slices of this task
+                std::vector<item> elements(axis_dim);
+                auto last = std::min(nslices, (task + 1) * grain);
+                for(auto i = task * grain; i < last; i++)
                 {
-                    out_idx[axis]                 = j;
-                    in_idx[axis]                  = sorted_indices[j];
-                    out_val[out_s.index(out_idx)] = input[in_s.index(in_idx)];
-                    out_ind[out_s.index(out_idx)] = sorted_indices[j];
+                    const auto* first = input.data() + (i / inner) * axis_dim * inner + i % inner;
+                    for(std::size_t j = 0; j < axis_dim; j++)
+                        elements[j] = {first[j * inner], j};
+                    select(elements, n, compare);
+                    auto out_offset = (i / inner) * k * inner + i % inner;
+                    for(std::size_t j = 0; j < n; j++)
+                    {
+                        out_val.data()[out_offset + j * inner] = elements[j].first;
+                        out_ind[out_offset + j * inner]        = elements[j].second;
+                    }
                 }
             });
         });
@@ -25,13 +25,18 @@
 #ifndef MIGRAPHX_GUARD_OPERATORS_UNIQUE_HPP
 #define MIGRAPHX_GUARD_OPERATORS_UNIQUE_HPP
 
-#include <migraphx/shape_for_each.hpp>
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/config.hpp>
 #include <migraphx/argument.hpp>
+#include <migraphx/hash.hpp>
+#include <migraphx/par.hpp>
+#include <migraphx/par_for.hpp>
 #include <migraphx/tune_axis.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
 #include <utility>
-#include <map>
 #include <limits>
 #include <optional>
 
@@ -76,85 +81,33 @@ namespace op {
 struct unique
 {
 
+    // Hash of a chunk of elements, from the bits of each element. Zero is hashed explicitly
+    // since -0.0 and 0.0 compare equal but have different bits.
     template <class T>
-    auto make_idx_less_fn(const T& data, size_t chunk_sz) const
+    static std::size_t hash_chunk(const T* first, size_t chunk_sz)
     {
-        return [&data, chunk_sz](auto idx1, auto idx2) {
-            return std::lexicographical_compare(data.begin() + idx1,
-                                                data.begin() + idx1 + chunk_sz,
-                                                data.begin() + idx2,
-                                                data.begin() + idx2 + chunk_sz);
-        };
-    }
-
-    // CASE SORTED:
-    //
-    // To process into a sorted unique series of elements/chunks:
-    // Chunk size == 1 means a simple element; >1 means a flat representation.
-    // Steps: first go through the input elements/chunks for uniqueness.
-    // At the end of this processing, per the sorted sequence of unique elements:
-    // update/create data structures: y, y_indices, x_rev_indices, y_count
-    //
-    // INPUT x: [2, 1, 1, 3, 4, 3], attr_sorted = 1;
-
-    // OUTPUT(s): indices..
-    // y_indices: [1, 0, 3, 4]  --- first incidence, in terms of index in sequence x
-    // x_rev_indices: [1, 0, 0, 2, 3, 2] --- x seen in terms of indices of unique sequence y
-    // y_count: [2, 1, 2, 1] -- count at each y_index. sum = len(x)
-
-    // NOTE: y [1, 2, 3, 4]   --- the unique output is constructed from x[y_indices[...]]
-
-    template <class T>
-    auto sorted_uniq_indices(const T& input_data, size_t chunk_sz) const
-    {
-        struct y_info
-        {
-            size_t y_idx;
-            size_t x_idx;
-            size_t ct = 0;
-        };
-
-        auto idx_less_fn = make_idx_less_fn(input_data, chunk_sz);
-        std::map<size_t, y_info, decltype(idx_less_fn)> uniq_val_map(idx_less_fn);
-
-        std::tuple<std::vector<std::size_t>, std::vector<std::size_t>, std::vector<std::size_t>> rv;
-        auto& [y_indices, x_rev_indices, y_count] = rv;
-
-        // go through all the elements and find the unique elements..
-        size_t count_x = input_data.size();
-        for(size_t f_idx = 0, x_idx = 0; f_idx < count_x; f_idx += chunk_sz, x_idx++)
+        std::size_t seed = 0;
+        for(const auto* it = first; it != first + chunk_sz; ++it)
         {
-            y_info entry          = {.y_idx = uniq_val_map.size(), .x_idx = x_idx};
-            auto [itr, added_new] = uniq_val_map.insert({f_idx, entry});
-            itr->second.ct++;
-            x_rev_indices.push_back(itr->second.y_idx);
+            std::uint64_t bits = 0;
+            if(not(*it == T(0)))
+                std::memcpy(&bits, it, std::min(sizeof(T), sizeof(bits)));
+            hash_combine(seed, bits);
         }
-
-        std::vector<std::size_t> y2x_indices(uniq_val_map.size());
-        y_indices.resize(uniq_val_map.size());
-        y_count.resize(uniq_val_map.size());
-        size_t idx = 0;
-        // the unique elements are now sorted:
-        // post-processing for all the return indices.
-        for(const auto& v : uniq_val_map)
-        {
-            y2x_indices[v.second.y_idx] = idx;
-            y_indices[idx]              = v.second.x_idx;
-            y_count[idx]                = v.second.ct;
-            idx++;
-        }
-        // update x_rev_indices as per the sorted order of y_indices
-        for(auto& i : x_rev_indices)
-            i = y2x_indices[i];
-
-        return rv;
+        // Mix the high bits into the low bits, which select the slot
+        seed ^= seed >> 33u;
+        seed *= 0xff51afd7ed558ccdull;
+        seed ^= seed >> 33u;
+        return seed;
     }
 
     // CASE UNSORTED:
     //
     // To process into an un-sorted unique series of elements/chunks:
     // For chunk size = 1 is a simple element, else use a flat representation of a tensor obj
-    // Go through the input elements/chunks one by one with inline processing of indices..
+    // The chunks are hashed in parallel, and then inserted one by one into an open addressing
+    // table (with linear probing) that holds the index of each unique chunk in y. A chunk is
+    // only compared to the unique chunks with the same hash.
 
     // INPUT x: [2, 1, 1, 3, 4, 3], attr_sorted = 0;
 
@@ -167,33 +120,106 @@ struct unique
     // Output data structures: y_indices, x_rev_indices, y_count are processed inline.
 
     template <class T>
-    auto unsorted_uniq_indices(const T& input_data, size_t chunk_sz) const
+    auto unsorted_uniq_indices(const std::vector<T>& input_data, size_t chunk_sz) const
     {
-        auto idx_less_fn = make_idx_less_fn(input_data, chunk_sz);
-        std::map<size_t, size_t, decltype(idx_less_fn)> uniq_val_map(idx_less_fn);
-
         // rv is used for NVRO below..
         std::tuple<std::vector<std::size_t>, std::vector<std::size_t>, std::vector<std::size_t>> rv;
         auto& [y_indices, x_rev_indices, y_count] = rv;
+        // there are no chunks when the input or the inner dimensions are empty
+        if(chunk_sz == 0 or input_data.empty())
+            return rv;
+
+        const size_t count_x = input_data.size() / chunk_sz;
+        const auto* data     = input_data.data();
+        std::vector<std::size_t> hashes(count_x);
+        par_for(count_x, 1024 / chunk_sz + 1, [&](auto i) {
+            hashes[i] = hash_chunk(data + i * chunk_sz, chunk_sz);
+        });
 
-        // go through all the elements and add the unique elements into the map..
-        // inline processing for outputs: y_indices, x_rev_indices, y_count
-        size_t count_x = input_data.size();
-        for(size_t f_idx = 0; f_idx < count_x; f_idx += chunk_sz)
+        std::size_t capacity = 16;
+        while(capacity < 2 * count_x)
+            capacity *= 2;
+        const std::size_t mask  = capacity - 1;
+        const std::size_t empty = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> table(capacity, empty);
+
+        x_rev_indices.resize(count_x);
+        for(size_t x_idx = 0; x_idx < count_x; x_idx++)
         {
-            auto [itr, added_new] = uniq_val_map.insert({f_idx, y_indices.size()});
-            if(added_new)
+            const auto* chunk = data + x_idx * chunk_sz;
+            auto slot         = hashes[x_idx] & mask;
+            while(table[slot] != empty)
+            {
+                auto first    = y_indices[table[slot]];
+                const auto* y = data + first * chunk_sz;
+                if(hashes[first] == hashes[x_idx] and std::equal(chunk, chunk + chunk_sz, y))
+                    break;
+                slot = (slot + 1) & mask;
+            }
+            if(table[slot] == empty)
             {
+                table[slot] = y_indices.size();
+                y_indices.push_back(x_idx);
                 y_count.push_back(0);
-                y_indices.push_back(x_rev_indices.size());
             }
-            y_count[itr->second]++;
-            x_rev_indices.push_back(itr->second);
+            y_count[table[slot]]++;
+            x_rev_indices[x_idx] = table[slot];
         }
 
         return rv;
     }
 
+    // CASE SORTED:
+    //
+    // To process into a sorted unique series of elements/chunks:
+    // Chunk size == 1 means a simple element; >1 means a flat representation.
+    // Steps: first find the unique elements/chunks as in the unsorted case. Then sort only the
+    // unique chunks, lexicographically, and permute y_indices and y_count into the sorted order
+    // and remap x_rev_indices to it.
+    //
+    // INPUT x: [2, 1, 1, 3, 4, 3], attr_sorted = 1;
+
+    // OUTPUT(s): indices..
+    // y_indices: [1, 0, 3, 4]  --- first incidence, in terms of index in sequence x
+    // x_rev_indices: [1, 0, 0, 2, 3, 2] --- x seen in terms of indices of unique sequence y
+    // y_count: [2, 1, 2, 1] -- count at each y_index. sum = len(x)
+
+    // NOTE: y [1, 2, 3, 4]   --- the unique output is constructed from x[y_indices[...]]
+
+    template <class T>
+    auto sorted_uniq_indices(const std::vector<T>& input_data, size_t chunk_sz) const
+    {
+        auto rv                                   = unsorted_uniq_indices(input_data, chunk_sz);
+        auto& [y_indices, x_rev_indices, y_count] = rv;
+
+        const auto* data = input_data.data();
+        std::vector<std::size_t> order(y_indices.size());
+        std::iota(order.begin(), order.end(), 0);
+        par_sort(order.begin(), order.end(), [&](auto a, auto b) {
+            const auto* x = data + y_indices[a] * chunk_sz;
+            const auto* y = data + y_indices[b] * chunk_sz;
+            return std::lexicographical_compare(x, x + chunk_sz, y, y + chunk_sz);
+        });
+
+        std::vector<std::size_t> y2x_indices(order.size());
+        std::vector<std::size_t> sorted_indices(order.size());
+        std::vector<std::size_t> sorted_count(order.size());
+        for(size_t idx = 0; idx < order.size(); idx++)
+        {
+            y2x_indices[order[idx]] = idx;
+            sorted_indices[idx]     = y_indices[order[idx]];
+            sorted_count[idx]       = y_count[order[idx]];
+        }
+        y_indices = std::move(sorted_indices);
+        y_count   = std::move(sorted_count);
+        // update x_rev_indices as per the sorted order of y_indices
+        par_for(x_rev_indices.size(), 1024, [&](auto i) {
+            x_rev_indices[i] = y2x_indices[x_rev_indices[i]];
+        });
+
+        return rv;
+    }
+
     // Axis. Default: none. Range: [-rank, rank-1]
     std::optional<int64_t> axis;
 
@@ -267,7 +293,7 @@ struct unique
         // For a built-in type, chunk_sz is of course = 1
         size_t chunk_sz = 1;
         if(axis)
-            chunk_sz = ct_x / lens_x[0]; // axis = 0 is supported.
+            chunk_sz = lens_x[0] == 0 ? 0 : ct_x / lens_x[0]; // axis = 0 is supported.
 
         visit_all(args.front(), res_y)([&](auto x, auto y_flat) {
             using o_type = typename decltype(x)::value_type;
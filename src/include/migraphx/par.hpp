@@ -97,6 +97,11 @@ template <class InputIt, class UnaryFunction>
 void par_for_each(InputIt first, InputIt last, UnaryFunction f)
 {
 #if MIGRAPHX_HAS_EXECUTORS
+    if(simple_par_for_serial())
+    {
+        std::for_each(first, last, std::move(f));
+        return;
+    }
     // Propagate the exception
     detail::exception_list ex;
     std::for_each(std::execution::par, first, last, ex.collect(std::move(f)));
@@ -0,0 +1,200 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_PREFIX_SCAN_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_PREFIX_SCAN_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/par_for.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Number of blocks to split each of nrows rows of n elements into, so that together there is
+ * about one block per thread, with each block at least min_block long. Rows are not split when
+ * there are at least as many rows as threads.
+ */
+inline std::size_t scan_block_count(std::size_t nrows, std::size_t n, std::size_t min_block)
+{
+    std::size_t nthreads = std::max(1u, std::thread::hardware_concurrency());
+    if(nrows >= nthreads)
+        return 1;
+    auto per_row = (nthreads + nrows - 1) / std::max<std::size_t>(nrows, 1);
+    return std::min(per_row, n / std::max<std::size_t>(min_block, 1));
+}
+
+/// Number of blocks to scan n elements with: one per thread, with each at least min_block long
+inline std::size_t scan_block_count(std::size_t n, std::size_t min_block)
+{
+    return scan_block_count(1, n, min_block);
+}
+
+/**
+ * Two-pass blocked scan over nrows independent rows of the range [0, n), each split into
+ * nblocks blocks:
+ *
+ * - reduce(row, first, last) returns the total of a block, and is run in parallel,
+ * - the totals of each row are exclusively scanned with op, starting from init,
+ * - scan(row, first, last, offset) is then run in parallel for every block, where offset is the
+ *   total of all the blocks before it in the row.
+ *
+ * The blocks of all the rows are run by the same par_for, so there is a single level of
+ * parallelism however the work is split between rows and blocks. With less than two blocks,
+ * the rows are scanned in parallel with scan(row, 0, n, init).
+ */
+template <class T, class Op, class Reduce, class Scan>
+void block_scan_rows(
+    std::size_t nrows, std::size_t n, std::size_t nblocks, T init, Op op, Reduce reduce, Scan scan)
+{
+    nblocks = std::min(nblocks, n);
+    if(nblocks < 2)
+    {
+        // Group short rows so each task has some work to do
+        auto grain = std::max<std::size_t>(1, 1024 / std::max<std::size_t>(n, 1));
+        par_for(nrows, grain, [&](std::size_t r) { scan(r, std::size_t{0}, n, init); });
+        return;
+    }
+    std::size_t block = (n + nblocks - 1) / nblocks;
+    nblocks           = (n + block - 1) / block;
+    auto bounds       = [&](std::size_t b) {
+        return std::make_pair(b * block, std::min(n, (b + 1) * block));
+    };
+
+    std::vector<T> totals(nrows * nblocks);
+    par_for(totals.size(), 1, [&](std::size_t i) {
+        auto [first, last] = bounds(i % nblocks);
+        totals[i]          = reduce(i / nblocks, first, last);
+    });
+    for(std::size_t r = 0; r < nrows; r++)
+    {
+        T acc = init;
+        for(std::size_t b = 0; b < nblocks; b++)
+        {
+            auto& total = totals[r * nblocks + b];
+            T x         = total;
+            total       = acc;
+            acc         = op(acc, x);
+        }
+    }
+    par_for(totals.size(), 1, [&](std::size_t i) {
+        auto [first, last] = bounds(i % nblocks);
+        scan(i / nblocks, first, last, totals[i]);
+    });
+}
+
+/**
+ * Two-pass blocked scan over the range [0, n), split into nblocks blocks:
+ *
+ * - reduce(first, last) returns the total of a block, and is run in parallel,
+ * - the totals are exclusively scanned with op, starting from init,
+ * - scan(first, last, offset) is then run in parallel for every block, where offset is the
+ *   total of all the blocks before it.
+ *
+ * With less than two blocks, scan(0, n, init) is called directly.
+ */
+template <class T, class Op, class Reduce, class Scan>
+void block_scan(std::size_t n, std::size_t nblocks, T init, Op op, Reduce reduce, Scan scan)
+{
+    block_scan_rows(
+        1,
+        n,
+        nblocks,
+        init,
+        op,
+        [&](std::size_t, std::size_t first, std::size_t last) { return reduce(first, last); },
+        [&](std::size_t, std::size_t first, std::size_t last, T acc) { scan(first, last, acc); });
+}
+
+/**
+ * In-place prefix scan with op of nrows rows, where row r is the n elements start(r)[0],
+ * start(r)[stride], ... and 0 is used as the identity of op. A negative stride scans in
+ * reverse. The rows and long rows are split between threads with block_scan_rows.
+ */
+template <class Start, class Op>
+void prefix_scan_rows(std::size_t nrows,
+                      Start start,
+                      std::size_t n,
+                      std::ptrdiff_t stride,
+                      bool exclusive,
+                      Op op)
+{
+    using type = std::remove_reference_t<decltype(*start(0))>;
+    auto at    = [&](std::size_t r, std::size_t i) -> type& {
+        return start(r)[static_cast<std::ptrdiff_t>(i) * stride];
+    };
+    type zero = type(0);
+    block_scan_rows(
+        nrows,
+        n,
+        scan_block_count(nrows, n, 4096),
+        zero,
+        op,
+        [&](std::size_t r, std::size_t first, std::size_t last) {
+            type acc = zero;
+            for(std::size_t i = first; i < last; i++)
+                acc = op(acc, at(r, i));
+            return acc;
+        },
+        [&](std::size_t r, std::size_t first, std::size_t last, type acc) {
+            if(exclusive)
+            {
+                for(std::size_t i = first; i < last; i++)
+                {
+                    type y   = at(r, i);
+                    at(r, i) = acc;
+                    acc      = op(acc, y);
+                }
+            }
+            else
+            {
+                for(std::size_t i = first; i < last; i++)
+                {
+                    acc      = op(acc, at(r, i));
+                    at(r, i) = acc;
+                }
+            }
+        });
+}
+
+/**
+ * In-place prefix scan of the n elements x[0], x[stride], ... with op, where 0 is used as the
+ * identity of op. A negative stride scans in reverse. Long rows are scanned in parallel with
+ * block_scan.
+ */
+template <class T, class Op>
+void prefix_scan(T* x, std::size_t n, std::ptrdiff_t stride, bool exclusive, Op op)
+{
+    prefix_scan_rows(1, [&](std::size_t) { return x; }, n, stride, exclusive, op);
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_PREFIX_SCAN_HPP
@@ -49,8 +49,12 @@ MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_EVAL)
 
 struct program_impl;
 
+struct buffer_pool;
+
 struct marker;
 
+struct specialization_cache;
+
 /**
  * @brief Stores the instruction stream
  */
@@ -84,6 +88,24 @@ struct MIGRAPHX_EXPORT program
 
     void finish() const;
 
+    /// Pool used for the host buffers allocated while evaluating the program
+    buffer_pool& get_buffer_pool() const;
+
+    /**
+     * Programs compiled for the input shapes of a dynamic program, when it was compiled with
+     * compile_options::specialize_cache_size, or nullptr otherwise
+     */
+    std::shared_ptr<const specialization_cache> get_specialization_cache() const;
+
+    /// Buffer of the state called name, which is allocated on the target of its instruction
+    argument get_state(const std::string& name) const;
+
+    /// Release the buffers of all the states so the next evaluation starts from zeros
+    void reset_state();
+
+    /// Number of times each submodule was run by the instructions of the program
+    const std::unordered_map<std::string, std::size_t>& get_module_runs() const;
+
     std::size_t size() const;
 
     std::vector<shape> get_output_shapes() const;
@@ -110,6 +132,14 @@ struct MIGRAPHX_EXPORT program
                      std::size_t batch = 1,
                      bool detailed     = false) const;
 
+    /**
+     * Run the program n times and record the time in milliseconds of every instruction. This
+     * throws for a program compiled with compile_options::specialize_cache_size, since the
+     * instructions belong to the specialized programs.
+     */
+    std::unordered_map<instruction_ref, std::vector<double>>
+    time_instructions(std::size_t n, const parameter_map& params) const;
+
     void mark(const parameter_map& params, marker&& m);
 
     value to_value() const;
@@ -41,6 +41,12 @@ struct module;
  */
 struct MIGRAPHX_EXPORT rewrite_rnn
 {
+    /**
+     * Keep the lstm and gru operators instead, for the targets that compute them directly. Their
+     * last hidden and cell state outputs are then taken from the operator itself.
+     */
+    bool keep_lstm_gru = false;
+
     std::string name() const { return "rewrite_rnn"; }
     void apply(module& m) const;
 
@@ -78,6 +84,9 @@ struct MIGRAPHX_EXPORT rewrite_rnn
 
     std::vector<operation> lstm_actv_funcs(instruction_ref ins) const;
 
+    // for lstm and gru operators that are kept
+    void replace_last_outputs(module& m, instruction_ref ins) const;
+
     bool is_variable_seq_lens(const module& m, instruction_ref seq_lens) const;
     instruction_ref replace_last_hs_output(module& m,
                                            instruction_ref ins,
@@ -0,0 +1,491 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_RNN_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_RNN_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/operation.hpp>
+#include <migraphx/op/common.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/tensor_view.hpp>
+#include <migraphx/type_traits.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Activation function of a recurrent cell, applied in place to contiguous blocks of values
+struct rnn_activation
+{
+    operation op;
+    std::string name;
+
+    rnn_activation(const operation& f) : op(f), name(f.name()) {}
+
+    template <class T>
+    void operator()(T* x, std::size_t n) const
+    {
+        if(n == 0)
+            return;
+        if(name == "sigmoid")
+            std::transform(x, x + n, x, [](T y) { return 1 / (1 + std::exp(-y)); });
+        else if(name == "tanh")
+            std::transform(x, x + n, x, [](T y) { return std::tanh(y); });
+        else if(name == "relu")
+            std::transform(x, x + n, x, [](T y) { return std::max<T>(y, 0); });
+        else
+        {
+            // Any other activation is computed by its operator on the whole block
+            shape s{shape::get_type<T>{}, {n}};
+            auto result = op.compute(s, {argument{s, x}});
+            result.visit([&](auto y) { std::copy(y.begin(), y.end(), x); });
+        }
+    }
+};
+
+/// Clamp the n values of x to [-clip, clip], when clip is set
+template <class T>
+void rnn_clip(T* x, std::size_t n, float clip)
+{
+    if(clip <= 0)
+        return;
+    std::transform(x, x + n, x, [&](T y) { return std::clamp<T>(y, -clip, clip); });
+}
+
+/// Input i of a recurrent operator, or an empty view when it is missing or undefined
+template <class T>
+tensor_view<T> rnn_input(const std::vector<argument>& args, std::size_t i)
+{
+    if(i >= args.size() or args[i].empty() or args[i].data() == nullptr)
+        return {};
+    return args[i].get<T>();
+}
+
+/// The length of the sequence of every batch, which is seq_len when there are no sequence lengths
+inline std::vector<std::size_t> rnn_seq_lens(const std::vector<argument>& args,
+                                              std::size_t i,
+                                              std::size_t seq_len,
+                                              std::size_t batch)
+{
+    std::vector<std::size_t> result(batch, seq_len);
+    if(i >= args.size() or args[i].empty() or args[i].data() == nullptr)
+        return result;
+    args[i].visit([&](auto lens) {
+        std::transform(lens.begin(), lens.end(), result.begin(), [&](auto x) {
+            return std::clamp<std::int64_t>(x, 0, seq_len);
+        });
+    });
+    return result;
+}
+
+/// Grain for a par_for over items that each do work multiply-adds
+inline std::size_t rnn_grain(std::size_t work)
+{
+    return std::max<std::size_t>(1, (1 << 16) / std::max<std::size_t>(1, work));
+}
+
+/// The matrix of direction d of a [directions, rows, cols] weight tensor, as a contiguous copy
+template <class V, class T>
+std::vector<V> rnn_weights(tensor_view<T> w, std::size_t d)
+{
+    std::vector<V> result;
+    if(w.empty())
+        return result;
+    const auto& lens = w.get_shape().lens();
+    result.reserve(lens[1] * lens[2]);
+    for(std::size_t i = 0; i < lens[1]; i++)
+    {
+        for(std::size_t j = 0; j < lens[2]; j++)
+            result.push_back(w(d, i, j));
+    }
+    return result;
+}
+
+/// The [batch, hidden_size] state of direction d, which is 0 when there is no initial state
+template <class V, class T>
+std::vector<V> rnn_initial_state(tensor_view<T> init, std::size_t d, std::size_t n)
+{
+    std::vector<V> result(n, 0);
+    if(not init.empty())
+    {
+        const auto& lens = init.get_shape().lens();
+        for(std::size_t i = 0; i < n; i++)
+            result[i] = init(d, i / lens[2], i % lens[2]);
+    }
+    return result;
+}
+
+/**
+ * The input projection x * w^T + bias of every timestep and batch at once, as a single
+ * [seq_len * batch, input_size] by [input_size, n] gemm, so only the recurrent part is left
+ * to compute for each timestep.
+ */
+template <class V, class T>
+std::vector<V>
+rnn_input_projection(tensor_view<T> x, const std::vector<V>& w, const std::vector<V>& bias)
+{
+    const auto& lens = x.get_shape().lens();
+    auto rows        = lens[0] * lens[1];
+    auto k           = lens[2];
+    auto n           = bias.size();
+    std::vector<V> result(rows * n);
+    par_for(rows, rnn_grain(n * k), [&](std::size_t row) {
+        std::vector<V> xr(k);
+        for(std::size_t i = 0; i < k; i++)
+            xr[i] = x(row / lens[1], row % lens[1], i);
+        auto* out = result.data() + row * n;
+        for(std::size_t j = 0; j < n; j++)
+            out[j] = std::inner_product(xr.begin(), xr.end(), w.data() + j * k, bias[j]);
+    });
+    return result;
+}
+
+/**
+ * The recurrent gemm of a timestep, h * r^T, for the gates [first, first + ngates) of the na
+ * active batches. hrow(a) is the state of the ath active batch, and the result is stored gate
+ * by gate as out[g, a, j], so every gate is a contiguous block for the activations.
+ */
+template <class V, class F>
+void rnn_recurrent_gemm(V* out,
+                        const std::vector<V>& r,
+                        std::size_t hs,
+                        std::size_t first,
+                        std::size_t ngates,
+                        std::size_t na,
+                        F hrow)
+{
+    auto n = ngates * hs;
+    par_for(na * n, rnn_grain(hs), [&](std::size_t i) {
+        auto a        = i / n;
+        auto col      = i % n;
+        const auto* h = hrow(a);
+        out[((col / hs) * na + a) * hs + col % hs] =
+            std::inner_product(h, h + hs, r.data() + (first * hs + col) * hs, V{0});
+    });
+}
+
+/// The batches that are active at a step of a direction, and the timestep each of them is at
+struct rnn_step
+{
+    std::vector<std::size_t> batches;
+    std::vector<std::size_t> times;
+};
+
+/**
+ * The steps of one direction. Batch b only runs for its first seq_lens[b] timesteps, which the
+ * reverse direction goes through backwards starting at seq_lens[b] - 1.
+ */
+inline std::vector<rnn_step> rnn_steps(const std::vector<std::size_t>& seq_lens, bool reverse)
+{
+    std::vector<rnn_step> result;
+    for(std::size_t i = 0;; i++)
+    {
+        rnn_step s;
+        for(std::size_t b = 0; b < seq_lens.size(); b++)
+        {
+            if(i >= seq_lens[b])
+                continue;
+            s.batches.push_back(b);
+            s.times.push_back(reverse ? seq_lens[b] - 1 - i : i);
+        }
+        if(s.batches.empty())
+            break;
+        result.push_back(std::move(s));
+    }
+    return result;
+}
+
+/// Zero the [seq_len, directions, batch, hidden_size] hidden states past the sequence lengths
+template <class T>
+void rnn_pad_hidden_states(tensor_view<T> hidden_states, const std::vector<std::size_t>& seq_lens)
+{
+    if(hidden_states.empty())
+        return;
+    const auto& lens = hidden_states.get_shape().lens();
+    for(std::size_t t = 0; t < lens[0]; t++)
+    {
+        for(std::size_t d = 0; d < lens[1]; d++)
+        {
+            for(std::size_t b = 0; b < lens[2]; b++)
+            {
+                if(t < seq_lens[b])
+                    continue;
+                for(std::size_t j = 0; j < lens[3]; j++)
+                    hidden_states(t, d, b, j) = T(0);
+            }
+        }
+    }
+}
+
+/// Write the [batch, hidden_size] state of direction d to a [directions, batch, hidden_size] output
+template <class T, class V>
+void rnn_last_output(tensor_view<T> output, std::size_t d, const std::vector<V>& state)
+{
+    if(output.empty())
+        return;
+    auto hs = output.get_shape().lens()[2];
+    for(std::size_t i = 0; i < state.size(); i++)
+        output(d, i / hs, i % hs) = T(state[i]);
+}
+
+/**
+ * LSTM over whole sequences, with the inputs of the lstm operator: x, w, r, and optionally
+ * bias, seq_lens, initial_h, initial_c and p. The hidden states of every timestep are written to
+ * hidden_states, and the final hidden and cell states to last_hs and last_cell when they are
+ * not empty. actv_funcs has the three activation functions of every direction.
+ */
+template <class T>
+void lstm(tensor_view<T> hidden_states,
+          tensor_view<T> last_hs,
+          tensor_view<T> last_cell,
+          const std::vector<argument>& args,
+          const std::vector<operation>& actv_funcs,
+          op::rnn_direction direction,
+          float clip,
+          bool input_forget)
+{
+    using value_type             = accumulator_type<T>;
+    constexpr std::size_t ngates = 4;
+    auto x                       = args[0].get<T>();
+    auto w                       = args[1].get<T>();
+    auto r                       = args[2].get<T>();
+    auto bias                    = rnn_input<T>(args, 3);
+    auto initial_h               = rnn_input<T>(args, 5);
+    auto initial_c               = rnn_input<T>(args, 6);
+    auto p                       = rnn_input<T>(args, 7);
+    auto batch                   = x.get_shape().lens()[1];
+    auto ndirs                   = w.get_shape().lens()[0];
+    auto hs                      = r.get_shape().lens()[2];
+    auto seq_lens                = rnn_seq_lens(args, 4, x.get_shape().lens()[0], batch);
+
+    rnn_pad_hidden_states(hidden_states, seq_lens);
+    std::vector<value_type> gates(ngates * batch * hs);
+    std::vector<value_type> hc(batch * hs);
+    for(std::size_t d = 0; d < ndirs; d++)
+    {
+        std::vector<rnn_activation> f(actv_funcs.begin() + 3 * d, actv_funcs.begin() + 3 * d + 3);
+        auto wd = rnn_weights<value_type>(w, d);
+        auto rd = rnn_weights<value_type>(r, d);
+        // The input and recurrent biases are both added to the input projection
+        std::vector<value_type> b(ngates * hs, 0);
+        for(std::size_t i = 0; i < b.size() and not bias.empty(); i++)
+            b[i] = value_type(bias(d, i)) + value_type(bias(d, i + ngates * hs));
+        // The peephole weights are in iof order
+        std::vector<value_type> pd;
+        for(std::size_t i = 0; i < 3 * hs and not p.empty(); i++)
+            pd.push_back(p(d, i));
+        auto xw = rnn_input_projection(x, wd, b);
+        auto h  = rnn_initial_state<value_type>(initial_h, d, batch * hs);
+        auto c  = rnn_initial_state<value_type>(initial_c, d, batch * hs);
+
+        bool reverse = direction == op::rnn_direction::reverse or d == 1;
+        for(const auto& s : rnn_steps(seq_lens, reverse))
+        {
+            auto na   = s.batches.size();
+            auto m    = na * hs;
+            auto hrow = [&](auto a) { return &h[s.batches[a] * hs]; };
+            auto xrow = [&](auto a) {
+                return &xw[(s.times[a] * batch + s.batches[a]) * ngates * hs];
+            };
+            rnn_recurrent_gemm(gates.data(), rd, hs, 0, ngates, na, hrow);
+            // The gates are in iofc order
+            auto* gi = gates.data();
+            auto* go = gi + m;
+            auto* gf = go + m;
+            auto* gc = gf + m;
+            for(std::size_t i = 0; i < m; i++)
+            {
+                auto a        = i / hs;
+                auto j        = i % hs;
+                auto bj       = s.batches[a] * hs + j;
+                const auto* z = xrow(a);
+                gi[i] += z[j];
+                go[i] += z[hs + j];
+                gf[i] += z[2 * hs + j];
+                gc[i] += z[3 * hs + j];
+                if(not pd.empty())
+                {
+                    gi[i] += pd[j] * c[bj];
+                    gf[i] += pd[2 * hs + j] * c[bj];
+                }
+            }
+            rnn_clip(gi, m, clip);
+            rnn_clip(gf, m, clip);
+            rnn_clip(gc, m, clip);
+            f[0](gi, m);
+            f[0](gf, m);
+            f[1](gc, m);
+            for(std::size_t i = 0; i < m; i++)
+            {
+                auto j  = i % hs;
+                auto bj = s.batches[i / hs] * hs + j;
+                if(input_forget)
+                    gf[i] = 1 - gi[i];
+                // Ct = ft (.) Ct-1 + it (.) ct
+                c[bj] = gf[i] * c[bj] + gi[i] * gc[i];
+                if(not pd.empty())
+                    go[i] += pd[hs + j] * c[bj];
+                hc[i] = c[bj];
+            }
+            rnn_clip(go, m, clip);
+            f[0](go, m);
+            f[2](hc.data(), m);
+            for(std::size_t i = 0; i < m; i++)
+            {
+                auto a  = i / hs;
+                auto j  = i % hs;
+                auto bj = s.batches[a] * hs + j;
+                // Ht = ot (.) h(Ct)
+                h[bj] = go[i] * hc[i];
+                if(not hidden_states.empty())
+                    hidden_states(s.times[a], d, s.batches[a], j) = T(h[bj]);
+            }
+        }
+        rnn_last_output(last_hs, d, h);
+        rnn_last_output(last_cell, d, c);
+    }
+}
+
+/**
+ * GRU over whole sequences, with the inputs of the gru operator: x, w, r, and optionally bias,
+ * seq_lens and initial_h. The hidden states of every timestep are written to hidden_states, and
+ * the final hidden state to last_hs when it is not empty. actv_funcs has the two activation
+ * functions of every direction.
+ */
+template <class T>
+void gru(tensor_view<T> hidden_states,
+         tensor_view<T> last_hs,
+         const std::vector<argument>& args,
+         const std::vector<operation>& actv_funcs,
+         op::rnn_direction direction,
+         float clip,
+         bool linear_before_reset)
+{
+    using value_type             = accumulator_type<T>;
+    constexpr std::size_t ngates = 3;
+    auto x                       = args[0].get<T>();
+    auto w                       = args[1].get<T>();
+    auto r                       = args[2].get<T>();
+    auto bias                    = rnn_input<T>(args, 3);
+    auto initial_h               = rnn_input<T>(args, 5);
+    auto batch                   = x.get_shape().lens()[1];
+    auto ndirs                   = w.get_shape().lens()[0];
+    auto hs                      = r.get_shape().lens()[2];
+    auto seq_lens                = rnn_seq_lens(args, 4, x.get_shape().lens()[0], batch);
+
+    rnn_pad_hidden_states(hidden_states, seq_lens);
+    std::vector<value_type> gates(ngates * batch * hs);
+    std::vector<value_type> rh(batch * hs);
+    std::vector<value_type> hh(batch * hs);
+    for(std::size_t d = 0; d < ndirs; d++)
+    {
+        std::vector<rnn_activation> f(actv_funcs.begin() + 2 * d, actv_funcs.begin() + 2 * d + 2);
+        auto wd = rnn_weights<value_type>(w, d);
+        auto rd = rnn_weights<value_type>(r, d);
+        // The recurrent biases of the z and r gates are added to the input projection, but the
+        // one of the h gate is added to the recurrent part, as it can be multiplied by rt
+        std::vector<value_type> b(ngates * hs, 0);
+        std::vector<value_type> rbh(hs, 0);
+        for(std::size_t i = 0; i < b.size() and not bias.empty(); i++)
+        {
+            b[i] = bias(d, i);
+            if(i < 2 * hs)
+                b[i] += value_type(bias(d, i + ngates * hs));
+            else
+                rbh[i - 2 * hs] = bias(d, i + ngates * hs);
+        }
+        auto xw = rnn_input_projection(x, wd, b);
+        auto h  = rnn_initial_state<value_type>(initial_h, d, batch * hs);
+
+        bool reverse = direction == op::rnn_direction::reverse or d == 1;
+        for(const auto& s : rnn_steps(seq_lens, reverse))
+        {
+            auto na   = s.batches.size();
+            auto m    = na * hs;
+            auto hrow = [&](auto a) { return &h[s.batches[a] * hs]; };
+            auto xrow = [&](auto a) {
+                return &xw[(s.times[a] * batch + s.batches[a]) * ngates * hs];
+            };
+            // Ht-1*(Rh^T) is only computed with the other gates with linear_before_reset
+            rnn_recurrent_gemm(gates.data(), rd, hs, 0, linear_before_reset ? 3 : 2, na, hrow);
+            // The gates are in zrh order
+            auto* gz = gates.data();
+            auto* gr = gz + m;
+            auto* gh = gr + m;
+            for(std::size_t i = 0; i < m; i++)
+            {
+                const auto* z = xrow(i / hs);
+                gz[i] += z[i % hs];
+                gr[i] += z[hs + i % hs];
+            }
+            rnn_clip(gz, m, clip);
+            rnn_clip(gr, m, clip);
+            f[0](gz, m);
+            f[0](gr, m);
+            if(linear_before_reset)
+            {
+                // ht = g(Xt*(Wh^T) + (rt (.) (Ht-1*(Rh^T) + Rbh)) + Wbh)
+                for(std::size_t i = 0; i < m; i++)
+                    hh[i] = gr[i] * (gh[i] + rbh[i % hs]);
+            }
+            else
+            {
+                // ht = g(Xt*(Wh^T) + (rt (.) Ht-1)*(Rh^T) + Rbh + Wbh)
+                for(std::size_t i = 0; i < m; i++)
+                    rh[i] = gr[i] * h[s.batches[i / hs] * hs + i % hs];
+                rnn_recurrent_gemm(
+                    hh.data(), rd, hs, 2, 1, na, [&](auto a) { return &rh[a * hs]; });
+                for(std::size_t i = 0; i < m; i++)
+                    hh[i] += rbh[i % hs];
+            }
+            for(std::size_t i = 0; i < m; i++)
+                hh[i] += xrow(i / hs)[2 * hs + i % hs];
+            rnn_clip(hh.data(), m, clip);
+            f[1](hh.data(), m);
+            for(std::size_t i = 0; i < m; i++)
+            {
+                auto a  = i / hs;
+                auto j  = i % hs;
+                auto bj = s.batches[a] * hs + j;
+                // Ht = (1 - zt) (.) ht + zt (.) Ht-1
+                h[bj] = (1 - gz[i]) * hh[i] + gz[i] * h[bj];
+                if(not hidden_states.empty())
+                    hidden_states(s.times[a], d, s.batches[a], j) = T(h[bj]);
+            }
+        }
+        rnn_last_output(last_hs, d, h);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_RNN_HPP
@@ -0,0 +1,58 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_SELECT_MODULE_STATISTICS_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_SELECT_MODULE_STATISTICS_HPP
+
+#include <migraphx/config.hpp>
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct program;
+
+/// How often the submodules of the select_module instructions were run
+struct select_module_statistics
+{
+    /// Runs of a submodule that matches the size of the dynamic dimension exactly
+    std::size_t exact = 0;
+    /// Runs of a submodule that pads the inputs up to a bigger submodule
+    std::size_t padded = 0;
+    /// Number of runs of every submodule
+    std::map<std::string, std::size_t> hits;
+};
+
+/**
+ * Statistics of the select_module instructions of the program, from the runs counted by the
+ * program. A submodule that runs another select_module, like the ones split_single_dyn_dim adds
+ * to pad the inputs, is counted as padded, and the select_module inside it is not counted again.
+ */
+MIGRAPHX_EXPORT select_module_statistics get_select_module_statistics(const program& p);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
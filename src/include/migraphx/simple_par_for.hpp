@@ -24,15 +24,37 @@
 #ifndef MIGRAPHX_GUARD_RTGLIB_SIMPLE_PAR_FOR_HPP
 #define MIGRAPHX_GUARD_RTGLIB_SIMPLE_PAR_FOR_HPP
 
+#include <migraphx/config.hpp>
 #include <thread>
 #include <cmath>
 #include <algorithm>
+#include <utility>
 #include <vector>
 #include <cassert>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+/// Whether simple_par_for runs serially on the calling thread
+MIGRAPHX_EXPORT bool& simple_par_for_serial();
+
+/**
+ * @brief Run simple_par_for serially on the current thread
+ *
+ * This is used by tasks that are already run in parallel with others, so the loops they run
+ * do not start threads of their own. The threads started by simple_par_for use it as well.
+ */
+struct serial_par_for_scope
+{
+    serial_par_for_scope() : prev(std::exchange(simple_par_for_serial(), true)) {}
+    serial_par_for_scope(const serial_par_for_scope&) = delete;
+    serial_par_for_scope& operator=(const serial_par_for_scope&) = delete;
+    ~serial_par_for_scope() { simple_par_for_serial() = prev; }
+
+    private:
+    bool prev;
+};
+
 struct joinable_thread : std::thread
 {
     template <class... Xs>
@@ -65,7 +87,7 @@ auto thread_invoke(std::size_t i, std::size_t, F f) -> decltype(f(i))
 template <class F>
 void simple_par_for_impl(std::size_t n, std::size_t threadsize, F f)
 {
-    if(threadsize <= 1)
+    if(threadsize <= 1 or simple_par_for_serial())
     {
         for(std::size_t i = 0; i < n; i++)
             thread_invoke(i, 0, f);
@@ -83,6 +105,7 @@ void simple_par_for_impl(std::size_t n, std::size_t threadsize, F f)
         std::size_t tid  = 0;
         std::generate(threads.begin(), threads.end(), [=, &work, &tid] {
             auto result = joinable_thread([=] {
+                serial_par_for_scope serial{};
                 std::size_t start = work;
                 std::size_t last  = std::min(n, work + grainsize);
                 for(std::size_t i = start; i < last; i++)
@@ -0,0 +1,144 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_SOFTMAX_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_SOFTMAX_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/tensor_view.hpp>
+#include <migraphx/type_traits.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Running maximum and sum of exponentials of a softmax row. Values are added a block at a time:
+ * the block maximum is found first, and the running sum is rescaled only when the maximum
+ * changes, so each element needs a single exp.
+ */
+template <class T>
+struct softmax_state
+{
+    T max = std::numeric_limits<T>::lowest();
+    T sum = 0;
+
+    template <class Iterator>
+    void add(Iterator first, Iterator last)
+    {
+        if(first == last)
+            return;
+        T m = std::max<T>(max, *std::max_element(first, last));
+        T s = 0;
+        for(auto it = first; it != last; ++it)
+            s += std::exp(*it - m);
+        sum = sum * std::exp(max - m) + s;
+        max = m;
+    }
+
+    /**
+     * Add the values like add, but replace each of them with its exp relative to the new
+     * maximum. Returns the factor that anything accumulated relative to the previous maximum
+     * needs to be rescaled by.
+     */
+    template <class Iterator>
+    T exp_add(Iterator first, Iterator last)
+    {
+        if(first == last)
+            return 1;
+        T m = std::max<T>(max, *std::max_element(first, last));
+        T s = 0;
+        for(auto it = first; it != last; ++it)
+        {
+            *it = std::exp(*it - m);
+            s += *it;
+        }
+        T scale = std::exp(max - m);
+        sum     = sum * scale + s;
+        max     = m;
+        return scale;
+    }
+
+    T exp(T x) const { return std::exp(x - max); }
+};
+
+/// Compute the softmax state of n values, where read(i) returns the ith value
+template <class T, class Read>
+softmax_state<T> online_softmax(std::size_t n, Read read)
+{
+    constexpr std::size_t block = 64;
+    softmax_state<T> state;
+    std::array<T, block> buffer;
+    for(std::size_t i = 0; i < n; i += block)
+    {
+        auto len = std::min(block, n - i);
+        for(std::size_t j = 0; j < len; j++)
+            buffer[j] = read(i + j);
+        state.add(buffer.begin(), buffer.begin() + len);
+    }
+    return state;
+}
+
+/**
+ * Softmax along axis of the input tensor. The result of each element is computed with
+ * f(exp(x - max), sum), so the same kernel can be used for softmax and logsoftmax. Rows are
+ * processed in parallel using strides, so no multi-index is computed per element.
+ */
+template <class Output, class Input, class F>
+void softmax(Output output, Input input, std::size_t axis, F f)
+{
+    using value_type  = accumulator_type<typename Input::value_type>;
+    const auto& in_s  = input.get_shape();
+    const auto& out_s = output.get_shape();
+    auto batch_lens   = in_s.lens();
+    auto n            = batch_lens[axis];
+    batch_lens[axis]  = 1;
+    shape batch_shape{shape::int32_type, batch_lens};
+    auto in_stride  = in_s.strides()[axis];
+    auto out_stride = out_s.strides()[axis];
+
+    par_for(batch_shape.elements(), [&](auto i) {
+        auto idx  = batch_shape.multi(i);
+        auto* out = output.data() + out_s.index(idx);
+        auto* in  = input.data() + in_s.index(idx);
+        auto run  = [&](auto read) {
+            auto state = online_softmax<value_type>(n, read);
+            for(std::size_t j = 0; j < n; j++)
+                out[j * out_stride] = f(state.exp(read(j)), state.sum);
+        };
+        // Contiguous rows get their own instantiation so the loads can be vectorized
+        if(in_stride == 1)
+            run([&](std::size_t j) -> value_type { return in[j]; });
+        else
+            run([&](std::size_t j) -> value_type { return in[j * in_stride]; });
+    });
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
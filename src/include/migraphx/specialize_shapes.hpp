@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_MIGRAPHX_SPECIALIZE_SHAPES_HPP
+#define MIGRAPHX_GUARD_MIGRAPHX_SPECIALIZE_SHAPES_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/target.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * Copy of the program where the parameters of the main module listed in shapes have those
+ * shapes instead, with the shapes of all the instructions after them recomputed.
+ */
+MIGRAPHX_EXPORT program specialize_shapes(const program& p,
+                                          const std::unordered_map<std::string, shape>& shapes);
+
+struct specialization_cache_impl;
+
+/**
+ * @brief Programs compiled for the static input shapes of a program with dynamic inputs
+ *
+ * The first time a set of input shapes is seen the program is specialized to them with
+ * specialize_shapes and compiled for the target, and it is reused for every input with the same
+ * shapes after that. At most `capacity` programs are kept, and the least recently used one is
+ * dropped first. Concurrent requests for the same shapes wait for a single compilation.
+ */
+struct MIGRAPHX_EXPORT specialization_cache
+{
+    struct statistics
+    {
+        /// Number of requests served by an already compiled program
+        std::size_t hits = 0;
+        /// Number of requests that had to compile a program
+        std::size_t misses = 0;
+        /// Number of programs compiled in the background from the optimals
+        std::size_t precompiled = 0;
+        /// Number of programs currently kept
+        std::size_t size = 0;
+    };
+
+    /// The program must not be compiled, and options.specialize_cache_size is the capacity
+    specialization_cache(const program& p, const target& t, const compile_options& options);
+    specialization_cache(const specialization_cache&) = delete;
+    specialization_cache& operator=(const specialization_cache&) = delete;
+    ~specialization_cache();
+
+    /// Compiled program for the shapes of the dynamic parameters in params
+    std::shared_ptr<const program> get(const parameter_map& params) const;
+
+    /**
+     * Compile the programs for every combination of the optimals of the dynamic dimensions, up
+     * to the capacity of the cache, on a background thread.
+     */
+    void precompile_optimals() const;
+
+    /// Wait for the background compilation to finish
+    void wait() const;
+
+    statistics get_statistics() const;
+
+    private:
+    std::unique_ptr<specialization_cache_impl> impl;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif // MIGRAPHX_GUARD_MIGRAPHX_SPECIALIZE_SHAPES_HPP
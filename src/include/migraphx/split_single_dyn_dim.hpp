@@ -35,9 +35,17 @@ inline namespace MIGRAPHX_INLINE_NS {
 /**
  * Split dynamic dimension over submodules if exactly one dimension in the parameter list is
  * dynamic.
+ *
+ * With bucketing, full submodules are only created for the optimals of the dynamic dimension and
+ * its max. The submodules for the other sizes pad their inputs with pad_value up to the next one
+ * of them, run it and slice the outputs back. The runs can be read with
+ * get_select_module_statistics.
  */
 struct MIGRAPHX_EXPORT split_single_dyn_dim
 {
+    bool bucketing  = false;
+    float pad_value = 0;
+
     std::string name() const { return "split_single_dyn_dim"; }
     void apply(module_pass_manager&) const;
 };
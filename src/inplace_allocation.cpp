@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/inplace_allocation.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+void inplace_allocation::apply(module& m) const
+{
+    auto implicit_deps = m.calc_implicit_deps();
+    // Find the last instruction that reads each allocation, either directly
+    // or through an instruction that aliases it
+    std::unordered_map<instruction_ref, instruction_ref> last_use;
+    for(auto ins : iterator_for(m))
+    {
+        auto add_uses = [&](const auto& inputs) {
+            for(auto input : inputs)
+            {
+                auto alias = instruction::get_output_alias(input);
+                if(alias->name() == allocation_op)
+                    last_use[alias] = ins;
+            }
+        };
+        add_uses(ins->inputs());
+        add_uses(implicit_deps[ins]);
+    }
+
+    for(auto ins : iterator_for(m))
+    {
+        if(not contains(ops, ins->name()))
+            continue;
+        if(ins->inputs().size() < 2)
+            continue;
+        auto alloc = ins->inputs().back();
+        if(alloc->name() != allocation_op or alloc->outputs().size() != 1)
+            continue;
+        if(instruction::get_output_alias(ins, true) != alloc)
+            continue;
+        auto input = ins->inputs().front();
+        // Same type, lens and strides so the elements line up
+        if(input->get_shape() != alloc->get_shape())
+            continue;
+        auto root = instruction::get_output_alias(input);
+        if(root->name() != allocation_op)
+            continue;
+        if(last_use.at(root) != ins)
+            continue;
+        // Other inputs reading the same buffer would see the partially written result
+        auto inputs = ins->inputs();
+        if(std::any_of(inputs.begin() + 1, inputs.end() - 1, [&](auto x) {
+               return instruction::get_output_alias(x) == root;
+           }))
+            continue;
+        // The output now aliases the input, so it keeps the buffer alive
+        // for as long as the output was used
+        last_use[root] = last_use.at(alloc);
+        inputs.back()  = input;
+        m.replace_instruction(ins, ins->get_operator(), inputs);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -0,0 +1,123 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/mark_state_writes.hpp>
+#include <migraphx/builtin.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The name of the state that ins refers to, or an empty string
+static std::string get_state_name(instruction_ref ins)
+{
+    auto alias = instruction::get_output_alias(ins);
+    if(alias->name() != "@state")
+        return {};
+    return any_cast<builtin::state>(alias->get_operator()).variable;
+}
+
+// The input as seen after the write: views of the state, or of an earlier write of it, are
+// made again on top of the write
+static instruction_ref
+view_of_write(module& m, instruction_ref pos, instruction_ref input, instruction_ref write)
+{
+    std::vector<instruction_ref> views;
+    auto x = input;
+    while(x->name() != "@state" and x->name() != "tensor_scatter")
+    {
+        views.push_back(x);
+        x = instruction::get_output_alias(x, true);
+    }
+    if(x == write)
+        return input;
+    auto result = write;
+    std::for_each(views.rbegin(), views.rend(), [&](auto view) {
+        auto inputs = view->inputs();
+        std::replace(inputs.begin(), inputs.end(), x, result);
+        x      = view;
+        result = m.insert_instruction(pos, view->get_operator(), inputs, view->module_inputs());
+    });
+    return result;
+}
+
+void mark_state_writes::apply(module& m) const
+{
+    // The last write of each state, and the instructions that used it since then
+    std::unordered_map<std::string, instruction_ref> last_write;
+    std::unordered_map<std::string, std::vector<instruction_ref>> readers;
+    for(auto ins : iterator_for(m))
+    {
+        bool write = ins->name() == "tensor_scatter" and ins->inputs().front()->name() == "@state";
+        // Later instructions see the result of the last write, also through views of the state
+        for(auto input : ins->inputs())
+        {
+            auto it = last_write.find(get_state_name(input));
+            if(it == last_write.end())
+                continue;
+            auto view = view_of_write(m, ins, input, it->second);
+            if(view != input)
+                instruction::replace_argument(ins, input, view);
+        }
+        if(not write)
+        {
+            for(auto input : ins->inputs())
+            {
+                auto name = get_state_name(input);
+                if(not name.empty())
+                    readers[name].push_back(ins);
+            }
+            continue;
+        }
+        auto name   = get_state_name(ins->inputs().front());
+        auto inputs = ins->inputs();
+        // The write indices are made explicit so the inputs after them are only dependencies
+        if(inputs.size() == 2)
+        {
+            auto batch = inputs.front()->get_shape().lens().front();
+            inputs.push_back(m.insert_literal(
+                ins, literal{shape{shape::int64_type, {batch}}, std::vector<int64_t>(batch, 0)}));
+        }
+        for(auto reader : readers[name])
+        {
+            if(not contains(inputs, reader))
+                inputs.push_back(reader);
+        }
+        auto v       = ins->get_operator().to_value();
+        v["inplace"] = true;
+        m.replace_instruction(ins, make_op("tensor_scatter", v), inputs);
+        readers[name].clear();
+        last_write[name] = ins;
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -285,6 +285,21 @@ struct allocation_segment
     }
 };
 
+// Find the alignment used by the loads of a submodule that has already been
+// colored, including any nested submodules that were folded into it
+static std::size_t find_load_alignment(const module& m)
+{
+    std::size_t alignment = 1;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() == "load" and ins->get_shape().bytes() > 0)
+            alignment = std::max(allocation_segment::compute_alignment(ins), alignment);
+        for(auto* smod : ins->module_inputs())
+            alignment = std::max(find_load_alignment(*smod), alignment);
+    }
+    return alignment;
+}
+
 static std::size_t find_max_alignment(const module& m, const std::string& allocation_op)
 {
     std::size_t alignment = 1;
@@ -297,9 +312,58 @@ static std::size_t find_max_alignment(const module& m, const std::string& alloca
     return alignment;
 }
 
+// Submodules are colored before their parent, so each one ends up with its
+// own scratch parameter. Instead of allocating these separately, the scratch
+// of the submodules is replaced with a single allocation in the parent
+// module, which is placed right before the instruction that runs the
+// submodules. Since the submodules read this allocation directly, it is an
+// implicit dependency of the instruction and stays live across it, so it
+// will only share memory with allocations that are not live while the
+// submodules run. All of the submodules of the same instruction (ie the
+// branches of `if` or `select_module`) cannot run at the same time so they
+// share the same allocation, which is sized for the largest of them.
+static std::size_t fold_submodule_scratch(module& m, const std::string& allocation_op)
+{
+    std::size_t alignment = 1;
+    std::unordered_set<module_ref> folded;
+    for(auto ins : iterator_for(m))
+    {
+        std::vector<std::pair<module_ref, instruction_ref>> scratches;
+        for(auto* smod : ins->module_inputs())
+        {
+            if(not folded.insert(smod).second)
+                continue;
+            auto mem = smod->get_parameter("scratch");
+            if(mem == smod->end() or mem->get_shape().bytes() == 0)
+                continue;
+            scratches.emplace_back(smod, mem);
+            // The allocation needs to respect the alignment the submodule was
+            // colored with
+            alignment = std::max(find_load_alignment(*smod), alignment);
+        }
+        if(scratches.empty())
+            continue;
+        std::size_t n = 0;
+        for(auto&& p : scratches)
+            n = std::max(n, p.second->get_shape().bytes());
+        auto alloc = m.insert_instruction(
+            ins, make_op(allocation_op, {{"shape", to_value(shape{shape::int8_type, {n}})}}));
+        for(auto&& [smod, mem] : scratches)
+        {
+            auto outputs = mem->outputs();
+            for(auto out : outputs)
+                instruction::replace_argument(out, mem, alloc);
+            smod->remove_instruction(mem);
+        }
+    }
+    return alignment;
+}
+
 void memory_coloring::apply(module& m) const
 {
-    const std::size_t alignment = find_max_alignment(m, allocation_op);
+    const std::size_t sub_alignment = fold_submodule_scratch(m, allocation_op);
+    const std::size_t alignment =
+        std::max(find_max_alignment(m, allocation_op), sub_alignment);
     auto conflict_table         = build_conflict_table(m, allocation_op);
     auto as                     = allocation_segment::build(m, conflict_table, alignment);
 
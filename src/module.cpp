@@ -178,6 +178,11 @@ void module::assign(const module& m)
             auto s   = ins->get_shape();
             copy_ins = impl->insert(impl->instructions.end(), {builtin::outline{s}, s, {}});
         }
+        else if(ins->name() == "@state")
+        {
+            copy_ins = impl->insert(impl->instructions.end(),
+                                    {ins->get_operator(), ins->get_shape(), {}});
+        }
         else
         {
             // if there are sub_module inputs, need to make a copy of the submodule
@@ -235,6 +240,11 @@ insert_generic_instructions_impl(module& m,
             auto s   = sins->get_shape();
             copy_ins = m.add_outline(s);
         }
+        else if(sins->name() == "@state")
+        {
+            auto&& name = any_cast<builtin::state>(sins->get_operator()).variable;
+            copy_ins    = m.add_state(name, sins->get_shape());
+        }
         else
         {
             auto mod_args = sins->module_inputs();
@@ -502,6 +512,11 @@ instruction_ref module::add_parameter(std::string name, shape s)
     return insert_parameter(begin(), std::move(name), std::move(s));
 }
 
+instruction_ref module::add_state(std::string name, shape s)
+{
+    return insert_state(begin(), std::move(name), std::move(s));
+}
+
 instruction_ref module::add_return(std::vector<instruction_ref> args)
 {
     shape instr_shape = compute_shape(builtin::returns{}, args);
@@ -526,6 +541,14 @@ instruction_ref module::insert_parameter(instruction_ref ins, std::string name,
     return std::prev(ins);
 }
 
+instruction_ref module::insert_state(instruction_ref ins, std::string name, shape s)
+{
+    if(s.dynamic())
+        MIGRAPHX_THROW("insert_state: state " + name + " can not have a dynamic shape");
+    impl->insert(ins, {builtin::state{std::move(name), s}, s, {}});
+    return std::prev(ins);
+}
+
 instruction_ref module::replace_return(std::vector<instruction_ref> args)
 {
     assert(std::all_of(args.begin(), args.end(), [&](auto ins) { return has_instruction(ins); }));
@@ -1227,6 +1250,13 @@ module::print_py(std::ostream& os,
                 print_py_shape(os, ins->get_shape());
                 os << ")" << std::endl;
             }
+            else if(ins->name() == "@state")
+            {
+                std::string name = any_cast<builtin::state>(ins->get_operator()).variable;
+                os << mname << ".add_state(" << enclose_name(name) << ", ";
+                print_py_shape(os, ins->get_shape());
+                os << ")" << std::endl;
+            }
             else if(ins->name() == "@return")
             {
                 os << mname << ".add_return([" << join_strings(input_vars, ", ") << "])"
@@ -1289,6 +1319,13 @@ module::print_cpp(std::ostream& os,
                 print_cpp_shape(os, ins->get_shape());
                 os << ");" << std::endl;
             }
+            else if(ins->name() == "@state")
+            {
+                std::string name = any_cast<builtin::state>(ins->get_operator()).variable;
+                os << mname << "->add_state(" << enclose_name(name) << ",";
+                print_cpp_shape(os, ins->get_shape());
+                os << ");" << std::endl;
+            }
             else if(ins->name() == "@return")
             {
                 os << mname << "->add_return({";
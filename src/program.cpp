@@ -39,7 +39,12 @@
 #include <migraphx/output_iterator.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/marker.hpp>
+#include <migraphx/mark_state_writes.hpp>
 #include <migraphx/supported_segments.hpp>
+#include <migraphx/buffer_pool.hpp>
+#include <migraphx/builtin.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/specialize_shapes.hpp>
 
 #include <iostream>
 #include <queue>
@@ -55,6 +60,8 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_BUFFER_POOL);
+
 using milliseconds = std::chrono::duration<double, std::milli>;
 
 struct mark_instruction_target
@@ -74,6 +81,13 @@ struct program_impl
     std::unordered_map<std::string, module> modules;
     std::vector<context> contexts;
     std::vector<target> targets;
+    buffer_pool pool;
+    // Buffers of the @state instructions, which are kept between evaluations
+    std::unordered_map<std::string, argument> states;
+    // Number of runs of each submodule, by its name
+    std::unordered_map<std::string, std::size_t> module_runs;
+    // Programs compiled for the input shapes, when the main module has dynamic inputs
+    std::shared_ptr<specialization_cache> specializations;
 };
 
 program::program() : impl(std::make_unique<program_impl>()) { this->create_module("main"); }
@@ -99,6 +113,10 @@ void program::assign(const program& p)
     }
 
     *impl = *p.impl;
+    // Each program keeps its own buffers
+    impl->pool        = buffer_pool{};
+    impl->states      = {};
+    impl->module_runs = {};
 
     // build a map from old ins to new ins
     // Build a map from old module to new module
@@ -268,7 +286,7 @@ void program::compile(const std::vector<target>& targets, std::vector<compile_op
         compile_opts.resize(targets.size(), migraphx::compile_options{});
     }
     // mark all the instruction as ref target first, later change target_id based on root-target
-    run_passes(*this, {mark_instruction_target{ref_target_id}});
+    run_passes(*this, {mark_instruction_target{ref_target_id}, mark_state_writes{}});
 
     // Run passes on each root target
     for(const auto i : range(targets.size()))
@@ -307,14 +325,35 @@ void program::compile(const target& t, compile_options options)
 {
     // todo: combine with multi-target compile method
     assert(not this->is_compiled());
+    auto param_shapes = this->get_parameter_shapes();
+    if(options.specialize_cache_size > 0 and
+       std::any_of(param_shapes.begin(), param_shapes.end(), [](const auto& pp) {
+           return pp.second.dynamic();
+       }))
+    {
+        // Each specialization would keep its own copy of the states
+        auto mods = this->get_modules();
+        if(std::any_of(mods.begin(), mods.end(), [](const module* m) {
+               return std::any_of(
+                   m->begin(), m->end(), [](const auto& ins) { return ins.name() == "@state"; });
+           }))
+            MIGRAPHX_THROW("specialize_cache_size is not supported for programs with a @state");
+        // Programs for the static input shapes are compiled when the program is evaluated
+        this->impl->specializations = std::make_shared<specialization_cache>(*this, t, options);
+        if(options.precompile_optimals)
+            this->impl->specializations->precompile_optimals();
+    }
     this->impl->targets  = {t};
     this->impl->contexts = {t.get_context()};
+    if(this->impl->specializations != nullptr)
+        return;
 
     if(enabled(MIGRAPHX_TRACE_COMPILE{}))
         options.trace = tracer{std::cout};
 
     options.trace(*this);
     options.trace();
+    run_passes(*this, {mark_state_writes{}}, options.trace);
     auto&& passes = t.get_passes(this->impl->contexts.front(), options);
     run_passes(*this, passes, options.trace);
     auto mods = this->get_modules();
@@ -426,9 +465,35 @@ void preview_argument(std::ostream& os, const argument& a)
         });
 }
 
+// The buffer of a @state instruction, which is allocated on its target and set to zero the first
+// time it is used
+static argument get_state_buffer(program_impl& impl, instruction_ref ins)
+{
+    const auto& name = any_cast<builtin::state>(ins->get_operator()).variable;
+    auto it          = impl.states.find(name);
+    if(it == impl.states.end())
+    {
+        // States live as long as the program, so they are not taken from the buffer pool
+        buffer_pool_scope no_pool{nullptr};
+        argument zeros{ins->get_shape()};
+        std::fill(zeros.data(), zeros.data() + zeros.get_shape().bytes(), 0);
+        // Allocating on the target does not clear the memory, so the zeros are copied to it
+        auto id    = ins->get_target_id();
+        auto state = id < impl.targets.size() ? impl.targets[id].copy_to(zeros) : zeros;
+        it         = impl.states.emplace(name, state).first;
+    }
+    if(it->second.get_shape() != ins->get_shape())
+    {
+        MIGRAPHX_THROW("Incorrect shape {" + to_string(ins->get_shape()) + "} for state: " + name +
+                       " should be: " + to_string(it->second.get_shape()));
+    }
+    return it->second;
+}
+
 template <class F>
 std::vector<argument> generic_eval(const module* mod,
                                    std::vector<context>& ctx,
+                                   program_impl& impl,
                                    std::unordered_map<std::string, argument> params,
                                    std::unordered_map<instruction_ref, argument> results,
                                    F trace)
@@ -468,6 +533,10 @@ std::vector<argument> generic_eval(const module* mod,
         {
             results.emplace(ins, trace(ins, [&] { return argument{ins->get_shape(), nullptr}; }));
         }
+        else if(name == "@state")
+        {
+            results.emplace(ins, trace(ins, [&] { return get_state_buffer(impl, ins); }));
+        }
         else if(name == "@return")
         {
             std::vector<argument> prog_outputs;
@@ -492,7 +561,8 @@ std::vector<argument> generic_eval(const module* mod,
             const auto& mod_args = ins->module_inputs();
             auto module_eval     = [&](module_ref smod,
                                    const std::unordered_map<std::string, argument>& inputs) {
-                return generic_eval(smod, ctx, inputs, results, trace);
+                impl.module_runs[smod->name()]++;
+                return generic_eval(smod, ctx, impl, inputs, results, trace);
             };
 
             results.emplace(
@@ -515,28 +585,36 @@ std::vector<argument> generic_eval(const module* mod,
 
 template <class F>
 std::vector<argument> generic_eval(const program& p,
-                                   std::vector<context>& ctx,
+                                   program_impl& impl,
                                    std::unordered_map<std::string, argument> params,
                                    F trace)
 {
     const module* mm = p.get_main_module();
-    return generic_eval(mm, ctx, params, {}, trace);
+    return generic_eval(mm, impl.contexts, impl, params, {}, trace);
 }
 
 std::vector<argument> program::eval_with_context(std::vector<context>& ctx,
                                                  parameter_map params) const
 {
+    if(this->impl->specializations != nullptr)
+        return this->impl->specializations->get(params)->eval_with_context(ctx, std::move(params));
     const module* mm = this->get_main_module();
-    return generic_eval(mm, ctx, std::move(params), {}, [](auto&&, auto f) { return f(); });
+    return generic_eval(mm, ctx, *impl, std::move(params), {}, [](auto&&, auto f) { return f(); });
 }
 
 std::vector<argument> program::eval(parameter_map params, execution_environment exec_env) const
 {
+    if(this->impl->specializations != nullptr)
+        return this->impl->specializations->get(params)->eval(std::move(params), exec_env);
+
     auto& contexts = this->impl->contexts;
 
     auto trace_level = value_of(MIGRAPHX_TRACE_EVAL{});
     std::vector<argument> ret;
 
+    buffer_pool_scope pool_scope{enabled(MIGRAPHX_DISABLE_BUFFER_POOL{}) ? get_current_buffer_pool()
+                                                                         : &this->impl->pool};
+
     if(exec_env.async)
     {
         assert(contexts.size() == 1);
@@ -552,7 +630,7 @@ std::vector<argument> program::eval(parameter_map params, execution_environment
             instruction::print(ss, x, ins_names);
             ins_out[x] = ss.str();
         });
-        ret = generic_eval(*this, contexts, std::move(params), [&](instruction_ref ins, auto f) {
+        ret = generic_eval(*this, *impl, std::move(params), [&](instruction_ref ins, auto f) {
             const auto& ctx = contexts[ins->get_target_id()];
             ctx.finish();
             std::cout << "Run instruction: " << ins_out.at(ins) << std::endl;
@@ -599,7 +677,7 @@ std::vector<argument> program::eval(parameter_map params, execution_environment
     }
     else
     {
-        ret = generic_eval(*this, contexts, std::move(params), [&](auto&&, auto f) { return f(); });
+        ret = generic_eval(*this, *impl, std::move(params), [&](auto&&, auto f) { return f(); });
     }
 
     if(exec_env.async)
@@ -611,6 +689,34 @@ std::vector<argument> program::eval(parameter_map params, execution_environment
     return ret;
 }
 
+buffer_pool& program::get_buffer_pool() const { return this->impl->pool; }
+
+std::shared_ptr<const specialization_cache> program::get_specialization_cache() const
+{
+    return this->impl->specializations;
+}
+
+argument program::get_state(const std::string& name) const
+{
+    for(const auto& pp : this->impl->modules)
+    {
+        for(auto ins : iterator_for(pp.second))
+        {
+            if(ins->name() == "@state" and
+               any_cast<builtin::state>(ins->get_operator()).variable == name)
+                return get_state_buffer(*this->impl, ins);
+        }
+    }
+    MIGRAPHX_THROW("State not found: " + name);
+}
+
+void program::reset_state() { this->impl->states.clear(); }
+
+const std::unordered_map<std::string, std::size_t>& program::get_module_runs() const
+{
+    return this->impl->module_runs;
+}
+
 void program::finish() const
 {
     for(const auto& ctx : this->impl->contexts)
@@ -712,6 +818,11 @@ static void mod_from_val(module_ref mod,
             output =
                 mod->insert_literal(mod->end(), migraphx::from_value<literal>(node.at("literal")));
         }
+        else if(name == "@state")
+        {
+            auto op = migraphx::from_value<builtin::state>(fields);
+            output  = mod->insert_state(mod->end(), op.variable, op.s);
+        }
         else
         {
             auto op = make_op(name, fields);
@@ -841,45 +952,47 @@ std::string perf_group(instruction_ref ins, bool detailed)
     return result;
 }
 
-void program::mark(const parameter_map& params, marker&& m)
+template <class Marker>
+static void
+mark_program(const program& p, program_impl& impl, const parameter_map& params, Marker& m)
 {
-    auto& ctx = this->impl->contexts;
     // Run once by itself
-    eval(params);
-    this->finish();
+    p.eval(params);
+    p.finish();
     // Start marking
-    m.mark_start(*this);
-    generic_eval(*this, ctx, params, [&](auto ins, auto f) {
+    m.mark_start(p);
+    generic_eval(p, impl, params, [&](auto ins, auto f) {
         argument result;
         m.mark_start(ins);
         result = f();
         m.mark_stop(ins);
         return result;
     });
-    m.mark_stop(*this);
+    m.mark_stop(p);
 }
 
-void program::perf_report(
-    std::ostream& os, std::size_t n, parameter_map params, std::size_t batch, bool detailed) const
+void program::mark(const parameter_map& params, marker&& m)
 {
-    auto& ctx = this->impl->contexts;
-    // Run once by itself
-    eval(params);
-    this->finish();
-    // Run and time entire program
-    std::vector<double> total_vec;
-    total_vec.reserve(n);
-    for(std::size_t i = 0; i < n; i++)
+    if(this->impl->specializations != nullptr)
     {
-        total_vec.push_back(time<milliseconds>([&] {
-            eval(params);
-            this->finish();
-        }));
+        // The instructions that are marked are the ones of the specialized program
+        auto sp = this->impl->specializations->get(params);
+        mark_program(*sp, *sp->impl, params, m);
+        return;
     }
-    std::sort(total_vec.begin(), total_vec.end());
+    mark_program(*this, *impl, params, m);
+}
+
+std::unordered_map<instruction_ref, std::vector<double>>
+program::time_instructions(std::size_t n, const parameter_map& params) const
+{
+    // The instructions would belong to a specialized program that the cache can drop
+    if(this->impl->specializations != nullptr)
+        MIGRAPHX_THROW("time_instructions: time the program from get_specialization_cache()->get "
+                       "instead");
     std::unordered_map<instruction_ref, std::vector<double>> ins_vec;
     // Fill the map
-    generic_eval(*this, ctx, params, [&](auto ins, auto) {
+    generic_eval(*this, *impl, params, [&](auto ins, auto) {
         ins_vec[ins].reserve(n);
         return argument{ins->get_shape(), nullptr};
     });
@@ -887,7 +1000,7 @@ void program::perf_report(
     // Run and time each instruction
     for(std::size_t i = 0; i < n; i++)
     {
-        generic_eval(*this, ctx, params, [&](auto ins, auto f) {
+        generic_eval(*this, *impl, params, [&](auto ins, auto f) {
             argument result;
             ins_vec[ins].push_back(time<milliseconds>([&] {
                 result = f();
@@ -896,6 +1009,33 @@ void program::perf_report(
             return result;
         });
     }
+    return ins_vec;
+}
+
+void program::perf_report(
+    std::ostream& os, std::size_t n, parameter_map params, std::size_t batch, bool detailed) const
+{
+    if(this->impl->specializations != nullptr)
+    {
+        this->impl->specializations->get(params)->perf_report(
+            os, n, std::move(params), batch, detailed);
+        return;
+    }
+    // Run once by itself
+    eval(params);
+    this->finish();
+    // Run and time entire program
+    std::vector<double> total_vec;
+    total_vec.reserve(n);
+    for(std::size_t i = 0; i < n; i++)
+    {
+        total_vec.push_back(time<milliseconds>([&] {
+            eval(params);
+            this->finish();
+        }));
+    }
+    std::sort(total_vec.begin(), total_vec.end());
+    auto ins_vec = time_instructions(n, params);
     for(auto&& p : ins_vec)
         std::sort(p.second.begin(), p.second.end());
     // Run and time implicit overhead
@@ -1062,8 +1202,12 @@ void program::print_cpp(std::ostream& os) const
 
 void program::dry_run(std::unordered_map<std::string, argument> params) const
 {
-    auto& ctx = this->impl->contexts;
-    generic_eval(*this, ctx, std::move(params), [](auto ins, auto&&...) {
+    if(this->impl->specializations != nullptr)
+    {
+        this->impl->specializations->get(params)->dry_run(std::move(params));
+        return;
+    }
+    generic_eval(*this, *impl, std::move(params), [](auto ins, auto&&...) {
         return argument{ins->get_shape(), nullptr};
     });
 }
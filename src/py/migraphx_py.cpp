@@ -359,6 +359,13 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
             },
             py::arg("name"),
             py::arg("shape"))
+        .def(
+            "add_state",
+            [](migraphx::module& mm, const std::string& name, const migraphx::shape shape) {
+                return mm.add_state(name, shape);
+            },
+            py::arg("name"),
+            py::arg("shape"))
         .def(
             "add_return",
             [](migraphx::module& mm, std::vector<migraphx::instruction_ref>& args) {
@@ -373,6 +380,8 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
         .def("get_parameter_shapes", &migraphx::program::get_parameter_shapes)
         .def("get_output_shapes", &migraphx::program::get_output_shapes)
         .def("is_compiled", &migraphx::program::is_compiled)
+        .def("get_state", &migraphx::program::get_state)
+        .def("reset_state", &migraphx::program::reset_state)
         .def(
             "compile",
             [](migraphx::program& p,
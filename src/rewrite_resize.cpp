@@ -0,0 +1,114 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/rewrite_resize.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/op/resize.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static instruction_ref interpolate_axis(module& m,
+                                        instruction_ref ins,
+                                        instruction_ref x,
+                                        std::size_t axis,
+                                        const op::resize::interpolation_table& table)
+{
+    auto out_len = table.indices.size() / table.taps;
+    auto lens    = x->get_shape().lens();
+    lens[axis]   = out_len;
+    auto result  = m.end();
+    for(std::size_t k = 0; k < table.taps; k++)
+    {
+        std::vector<int32_t> indices(out_len);
+        std::vector<double> weights(out_len);
+        for(std::size_t i = 0; i < out_len; i++)
+        {
+            indices[i] = table.indices[i * table.taps + k];
+            weights[i] = table.weights[i * table.taps + k];
+        }
+        if(std::all_of(weights.begin(), weights.end(), [](auto w) { return w == 0; }))
+            continue;
+        auto idx = m.add_literal(literal{shape{shape::int32_type, {out_len}}, indices});
+        auto w   = m.add_literal(literal{shape{x->get_shape().type(), {out_len}}, weights});
+        auto tap = m.insert_instruction(ins, make_op("gather", {{"axis", axis}}), x, idx);
+        auto bw  = m.insert_instruction(
+            ins, make_op("broadcast", {{"axis", axis}, {"out_lens", lens}}), w);
+        tap = m.insert_instruction(ins, make_op("mul"), tap, bw);
+        if(result == m.end())
+            result = tap;
+        else
+            result = m.insert_instruction(ins, make_op("add"), result, tap);
+    }
+    return result;
+}
+
+static void replace_with_gather(module& m, instruction_ref ins)
+{
+    auto op       = any_cast<op::resize>(ins->get_operator());
+    auto input    = ins->inputs().front();
+    auto in_lens  = input->get_shape().lens();
+    auto out_lens = ins->get_shape().lens();
+    std::vector<float> scales(in_lens.size());
+    std::transform(out_lens.begin(),
+                   out_lens.end(),
+                   in_lens.begin(),
+                   scales.begin(),
+                   [](auto out_len, auto in_len) { return float(out_len) / in_len; });
+    if(not op.scales.empty())
+        scales = op.scales;
+
+    auto x = input;
+    for(std::size_t axis = 0; axis < in_lens.size(); axis++)
+    {
+        auto table = op.make_interpolation_table(in_lens[axis], out_lens[axis], scales[axis]);
+        if(in_lens[axis] == out_lens[axis] and table.is_identity())
+            continue;
+        x = interpolate_axis(m, ins, x, axis, table);
+    }
+    m.replace_instruction(ins, x);
+}
+
+void rewrite_resize::apply(module& m) const
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "resize" or ins->inputs().size() != 1 or ins->get_shape().dynamic())
+            continue;
+        if(ins->get_operator().to_value()["mode"].to<std::string>() == "nearest")
+            continue;
+        bool is_float = false;
+        ins->get_shape().visit_type([&](auto as) {
+            using type = typename decltype(as)::type;
+            is_float   = not std::is_integral<type>{};
+        });
+        if(is_float)
+            replace_with_gather(m, ins);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
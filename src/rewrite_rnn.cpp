@@ -58,6 +58,10 @@ void rewrite_rnn::apply(module& m) const
         {
             apply_vanilla_rnn(m, ins);
         }
+        else if(keep_lstm_gru and contains({"gru", "lstm"}, ins->name()))
+        {
+            replace_last_outputs(m, ins);
+        }
         else if(ins->name() == "gru")
         {
             apply_gru(m, ins);
@@ -724,42 +728,10 @@ std::vector<instruction_ref> rewrite_rnn::gru_cell(bool is_forward,
 
 std::vector<operation> rewrite_rnn::gru_actv_funcs(instruction_ref ins) const
 {
-    auto gru_op = any_cast<op::gru>(ins->get_operator());
     // before rewrite the gru operator, need to ensure
     // we have 4 actv funcs, even though a user does not
-    // specifiy any actv func. If less than 4, use the
-    // algorithm in parse_gru to make 4 actv functions
-    if(gru_op.direction == op::rnn_direction::bidirectional)
-    {
-        if(gru_op.actv_funcs.empty())
-            return {make_op("sigmoid"), make_op("tanh"), make_op("sigmoid"), make_op("tanh")};
-        else if(gru_op.actv_funcs.size() == 1)
-            return {gru_op.actv_funcs.at(0),
-                    gru_op.actv_funcs.at(0),
-                    gru_op.actv_funcs.at(0),
-                    gru_op.actv_funcs.at(0)};
-        else if(gru_op.actv_funcs.size() == 2)
-            return {gru_op.actv_funcs.at(0),
-                    gru_op.actv_funcs.at(1),
-                    gru_op.actv_funcs.at(0),
-                    gru_op.actv_funcs.at(1)};
-        else if(gru_op.actv_funcs.size() == 3)
-            return {gru_op.actv_funcs.at(0),
-                    gru_op.actv_funcs.at(1),
-                    gru_op.actv_funcs.at(2),
-                    gru_op.actv_funcs.at(0)};
-        else
-            return gru_op.actv_funcs;
-    }
-    else
-    {
-        if(gru_op.actv_funcs.empty())
-            return {make_op("sigmoid"), make_op("tanh")};
-        else if(gru_op.actv_funcs.size() == 1)
-            return {gru_op.actv_funcs.at(0), gru_op.actv_funcs.at(0)};
-        else
-            return gru_op.actv_funcs;
-    }
+    // specifiy any actv func.
+    return any_cast<op::gru>(ins->get_operator()).get_actv_funcs();
 }
 
 // for lstm operators
@@ -1203,81 +1175,31 @@ std::vector<instruction_ref> rewrite_rnn::lstm_cell(bool is_forward,
 
 std::vector<operation> rewrite_rnn::lstm_actv_funcs(instruction_ref ins) const
 {
-    auto lstm_op = any_cast<op::lstm>(ins->get_operator());
     // before rewrite the lstm operator, need to ensure
     // we have 6 actv funcs, even though a user does not
-    // specifiy any actv func. If less than 46, use the
-    // algorithm in parse_lstm to make 6 actv functions
-    const auto& actv_funcs     = lstm_op.actv_funcs;
-    std::size_t num_actv_funcs = actv_funcs.size();
-    if(lstm_op.direction == op::rnn_direction::bidirectional)
-    {
-        switch(num_actv_funcs)
-        {
-        case 0:
-            return {make_op("sigmoid"),
-                    make_op("tanh"),
-                    make_op("tanh"),
-                    make_op("sigmoid"),
-                    make_op("tanh"),
-                    make_op("tanh")};
-
-        case 1:
-            return {actv_funcs.at(0),
-                    actv_funcs.at(0),
-                    actv_funcs.at(0),
-                    actv_funcs.at(0),
-                    actv_funcs.at(0),
-                    actv_funcs.at(0)};
-
-        case 2:
-            return {actv_funcs.at(0),
-                    actv_funcs.at(1),
-                    actv_funcs.at(1),
-                    actv_funcs.at(0),
-                    actv_funcs.at(1),
-                    actv_funcs.at(1)};
-
-        case 3:
-            return {actv_funcs.at(0),
-                    actv_funcs.at(1),
-                    actv_funcs.at(2),
-                    actv_funcs.at(0),
-                    actv_funcs.at(1),
-                    actv_funcs.at(2)};
-
-        case 4:
-            return {actv_funcs.at(0),
-                    actv_funcs.at(1),
-                    actv_funcs.at(2),
-                    actv_funcs.at(3),
-                    actv_funcs.at(3),
-                    actv_funcs.at(3)};
-
-        case 5:
-            return {actv_funcs.at(0),
-                    actv_funcs.at(1),
-                    actv_funcs.at(2),
-                    actv_funcs.at(3),
-                    actv_funcs.at(4),
-                    actv_funcs.at(4)};
-
-        default: return actv_funcs;
-        }
-    }
-    else
-    {
-        switch(num_actv_funcs)
-        {
-        case 0: return {make_op("sigmoid"), make_op("tanh"), make_op("tanh")};
-
-        case 1: return {actv_funcs.at(0), actv_funcs.at(0), actv_funcs.at(0)};
-
-        case 2: return {actv_funcs.at(0), actv_funcs.at(1), actv_funcs.at(1)};
+    // specifiy any actv func.
+    return any_cast<op::lstm>(ins->get_operator()).get_actv_funcs();
+}
 
-        default: return actv_funcs;
-        }
-    }
+// The lstm or gru operator is kept, so its rnn_last_hs_output and rnn_last_cell_output are
+// replaced by the last outputs of the operator itself
+void rewrite_rnn::replace_last_outputs(module& m, instruction_ref ins) const
+{
+    auto hs_outputs =
+        find_all(ins->outputs(), [&](auto i) { return i->name() == "rnn_last_hs_output"; });
+    auto cell_outputs =
+        find_all(ins->outputs(), [&](auto i) { return i->name() == "rnn_last_cell_output"; });
+    if(hs_outputs.empty() and cell_outputs.empty())
+        return;
+
+    auto v            = ins->get_operator().to_value();
+    v["last_outputs"] = true;
+    auto rnn          = m.insert_instruction(ins, make_op(ins->name(), v), ins->inputs());
+    for(auto hs_out : hs_outputs)
+        m.replace_instruction(hs_out, make_op("get_tuple_elem", {{"index", 1}}), rnn);
+    for(auto cell_out : cell_outputs)
+        m.replace_instruction(cell_out, make_op("get_tuple_elem", {{"index", 2}}), rnn);
+    m.replace_instruction(ins, make_op("get_tuple_elem", {{"index", 0}}), rnn);
 }
 
 bool rewrite_rnn::is_variable_seq_lens(const module& m, instruction_ref seq_lens) const
@@ -0,0 +1,101 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/select_module_statistics.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static bool has_select_module(const_module_ref m)
+{
+    return std::any_of(
+        m->begin(), m->end(), [](const auto& ins) { return ins.name() == "select_module"; });
+}
+
+select_module_statistics get_select_module_statistics(const program& p)
+{
+    const auto& runs = p.get_module_runs();
+    // The submodules that pad the inputs run a select_module themselves
+    std::unordered_set<const_module_ref> padding;
+    for(const auto* m : p.get_modules())
+    {
+        for(auto ins : iterator_for(*m))
+        {
+            if(ins->name() != "select_module")
+                continue;
+            for(const auto* smod : ins->module_inputs())
+            {
+                if(has_select_module(smod))
+                    padding.insert(smod);
+            }
+        }
+    }
+    auto get_runs = [&](const_module_ref m) -> std::size_t {
+        auto it = runs.find(m->name());
+        return it == runs.end() ? 0 : it->second;
+    };
+    // Runs of the submodules from the select_module inside the padding submodules, which each
+    // run the one bucket they pad to
+    std::unordered_map<const_module_ref, std::size_t> padded_runs;
+    for(const auto* m : padding)
+    {
+        for(auto ins : iterator_for(*m))
+        {
+            if(ins->name() == "select_module" and ins->module_inputs().size() == 1)
+                padded_runs[ins->module_inputs().front()] += get_runs(m);
+        }
+    }
+    select_module_statistics result;
+    for(const auto* m : p.get_modules())
+    {
+        if(contains(padding, m))
+            continue;
+        for(auto ins : iterator_for(*m))
+        {
+            if(ins->name() != "select_module")
+                continue;
+            for(const auto* smod : ins->module_inputs())
+            {
+                auto n = get_runs(smod) - std::min(get_runs(smod), padded_runs[smod]);
+                if(n == 0)
+                    continue;
+                result.hits[smod->name()] += n;
+                if(contains(padding, smod))
+                    result.padded += n;
+                else
+                    result.exact += n;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
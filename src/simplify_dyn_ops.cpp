@@ -27,6 +27,7 @@
 #include <migraphx/make_op.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/op/resize.hpp>
+#include <migraphx/op/select_module.hpp>
 #include <migraphx/common.hpp>
 #include <migraphx/tensor_view.hpp>
 
@@ -63,7 +64,8 @@ struct find_broadcast_with_dims_static
 };
 
 /**
- * Convert a Resize op. with Nearest mode to an implementation using Gather op.
+ * Convert a Resize op. with Nearest mode to an implementation using Gather op. Other modes are
+ * converted to a single input Resize with constant sizes or scales.
  * From:  resize[scales={...}/sizes={...},](static, constant)
  * To:
  * 0 = literal{ ... } computed_indices
@@ -98,12 +100,14 @@ struct find_resize_static
         auto in_lens = inputs.at(0)->get_shape().lens();
         std::vector<size_t> sizes_vec(inputs.at(0)->get_shape().ndim());
         std::vector<float> scales_vec(inputs.at(0)->get_shape().ndim());
+        bool use_sizes = false;
         //  populate both scales and sizes for the benefit of the algorithm.
         inputs.at(1)->eval().visit([&](auto input) {
             using type = typename decltype(input)::value_type;
             if constexpr(std::is_integral<type>{})
             {
                 // read output sizes and use them to compute scales
+                use_sizes = true;
                 sizes_vec.assign(input.begin(), input.end());
                 std::transform(
                     input.begin(),
@@ -125,6 +129,15 @@ struct find_resize_static
             }
         });
 
+        // Linear and cubic modes are kept as a resize with constant sizes or scales
+        if(resize_op.mode != "nearest")
+        {
+            resize_op.sizes  = use_sizes ? sizes_vec : std::vector<size_t>{};
+            resize_op.scales = use_sizes ? std::vector<float>{} : scales_vec;
+            m.replace_instruction(ins, resize_op, inputs.at(0));
+            return;
+        }
+
         auto in_s = inputs.at(0)->get_shape();
         shape out_s{in_s.type(), sizes_vec};
 
@@ -524,12 +537,10 @@ struct simplify_select_module_output_shape
                            [&](auto output_shapes) { return output_shapes.at(i); });
             dyn_shapes.at(i) = dyn_shape_from_shapes(shapes_at_index);
         }
-        auto tuple_shape = shape{dyn_shapes};
-        m.replace_instruction(
-            sm_ins,
-            make_op("select_module", {{"output_dyn_shapes", to_value(tuple_shape)}}),
-            sm_ins->inputs(),
-            sm_module_inputs);
+        // keep the other attributes of the operator
+        auto sm_op              = any_cast<op::select_module>(sm_ins->get_operator());
+        sm_op.output_dyn_shapes = shape{dyn_shapes};
+        m.replace_instruction(sm_ins, sm_op, sm_ins->inputs(), sm_module_inputs);
     }
 
     std::vector<std::size_t> get_shapes_ndim(const std::vector<shape>& shapes) const
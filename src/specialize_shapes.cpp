@@ -0,0 +1,303 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/specialize_shapes.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+program specialize_shapes(const program& p, const std::unordered_map<std::string, shape>& shapes)
+{
+    program result = p;
+    auto* mm       = result.get_main_module();
+    module sm{mm->name()};
+    std::unordered_map<instruction_ref, instruction_ref> map_ins;
+    for(const auto& name : mm->get_parameter_names())
+    {
+        auto param     = mm->get_parameter(name);
+        auto it        = shapes.find(name);
+        auto s         = it == shapes.end() ? param->get_shape() : it->second;
+        map_ins[param] = sm.insert_parameter(sm.end(), name, s);
+    }
+    auto outputs = sm.add_instructions(mm, &map_ins);
+    sm.add_return(outputs);
+    *mm = sm;
+    return result;
+}
+
+struct specialization_cache_impl
+{
+    using program_future = std::shared_future<std::shared_ptr<const program>>;
+    using entry          = std::pair<std::string, program_future>;
+
+    program prog;
+    target t;
+    compile_options options;
+    std::size_t capacity;
+    // Shapes of the dynamic parameters of the main module
+    std::unordered_map<std::string, shape> dynamic_params;
+
+    mutable std::mutex mutex;
+    std::list<entry> items;
+    std::unordered_map<std::string, std::list<entry>::iterator> lookup;
+    specialization_cache::statistics stats;
+
+    std::atomic<bool> stopped{false};
+    std::thread background;
+
+    specialization_cache_impl(const program& p, const target& tgt, const compile_options& opts)
+        : prog(p),
+          t(tgt),
+          options(opts),
+          capacity(std::max<std::size_t>(1, opts.specialize_cache_size))
+    {
+        // The specializations have static shapes, so they are compiled normally
+        options.specialize_cache_size = 0;
+        for(auto&& [name, s] : prog.get_main_module()->get_parameter_shapes())
+        {
+            if(s.dynamic())
+                dynamic_params.emplace(name, s);
+        }
+    }
+
+    ~specialization_cache_impl()
+    {
+        stopped = true;
+        if(background.joinable())
+            background.join();
+    }
+
+    // Key of the static shapes given to the dynamic parameters
+    std::string make_key(const std::unordered_map<std::string, shape>& shapes) const
+    {
+        std::vector<std::string> names;
+        std::transform(dynamic_params.begin(),
+                       dynamic_params.end(),
+                       std::back_inserter(names),
+                       [](const auto& pp) { return pp.first; });
+        std::sort(names.begin(), names.end());
+        std::string key;
+        for(const auto& name : names)
+        {
+            const auto& s = shapes.at(name);
+            key += name + ":" + to_string_range(s.lens()) + ":" + to_string_range(s.strides());
+            key += ";";
+        }
+        return key;
+    }
+
+    // Move the entry to the front and drop the least recently used ones over the capacity
+    void touch(std::list<entry>::iterator it)
+    {
+        items.splice(items.begin(), items, it);
+        while(items.size() > capacity)
+        {
+            lookup.erase(items.back().first);
+            items.pop_back();
+        }
+    }
+
+    // Find the compiled program for the shapes, or compile it when it is not in the cache
+    std::shared_ptr<const program> get(const std::unordered_map<std::string, shape>& shapes,
+                                       bool precompile)
+    {
+        auto key = make_key(shapes);
+        std::promise<std::shared_ptr<const program>> promise;
+        program_future future;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = lookup.find(key);
+            if(it != lookup.end())
+            {
+                if(not precompile)
+                    stats.hits++;
+                touch(it->second);
+                future = it->second->second;
+            }
+            else
+            {
+                if(precompile)
+                    stats.precompiled++;
+                else
+                    stats.misses++;
+                future = promise.get_future().share();
+                items.emplace_front(key, future);
+                lookup[key] = items.begin();
+                touch(items.begin());
+                // Compile outside of the lock, other requests for the same key wait on the future
+                future = {};
+            }
+        }
+        if(future.valid())
+            return future.get();
+        try
+        {
+            auto p = std::make_shared<program>(specialize_shapes(prog, shapes));
+            p->compile(t, options);
+            promise.set_value(p);
+            return p;
+        }
+        catch(...)
+        {
+            promise.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = lookup.find(key);
+            if(it != lookup.end())
+            {
+                items.erase(it->second);
+                lookup.erase(it);
+            }
+            throw;
+        }
+    }
+
+    // Every combination of the optimals of the distinct dynamic dimensions, up to the capacity
+    std::vector<std::unordered_map<std::string, shape>> optimal_shapes() const
+    {
+        std::vector<shape::dynamic_dimension> dims;
+        for(const auto& pp : dynamic_params)
+        {
+            for(const auto& dd : pp.second.dyn_dims())
+            {
+                if(not dd.is_fixed() and not contains(dims, dd))
+                    dims.push_back(dd);
+            }
+        }
+        if(std::any_of(dims.begin(), dims.end(), [](const auto& dd) {
+               return not dd.has_optimal();
+           }))
+            return {};
+        std::vector<std::unordered_map<std::string, shape>> result;
+        std::vector<std::size_t> values(dims.size());
+        auto combine = [&](auto self, std::size_t i) -> void {
+            if(result.size() >= capacity)
+                return;
+            if(i == dims.size())
+            {
+                std::unordered_map<std::string, shape> shapes;
+                for(const auto& [name, s] : dynamic_params)
+                {
+                    std::vector<std::size_t> lens;
+                    for(const auto& dd : s.dyn_dims())
+                    {
+                        auto d = std::find(dims.begin(), dims.end(), dd);
+                        lens.push_back(d == dims.end() ? dd.min : values[d - dims.begin()]);
+                    }
+                    shapes.emplace(name, shape{s.type(), lens});
+                }
+                result.push_back(shapes);
+                return;
+            }
+            for(auto x : dims[i].optimals)
+            {
+                values[i] = x;
+                self(self, i + 1);
+            }
+        };
+        combine(combine, 0);
+        return result;
+    }
+};
+
+specialization_cache::specialization_cache(const program& p,
+                                           const target& t,
+                                           const compile_options& options)
+    : impl(std::make_unique<specialization_cache_impl>(p, t, options))
+{
+    if(p.is_compiled())
+        MIGRAPHX_THROW("specialization_cache: program is already compiled");
+}
+
+specialization_cache::~specialization_cache() = default;
+
+std::shared_ptr<const program> specialization_cache::get(const parameter_map& params) const
+{
+    std::unordered_map<std::string, shape> shapes;
+    for(const auto& [name, s] : impl->dynamic_params)
+    {
+        auto it = params.find(name);
+        if(it == params.end())
+            MIGRAPHX_THROW("Parameter not found: " + name);
+        const auto& as = it->second.get_shape();
+        const auto& dd = s.dyn_dims();
+        auto in_range  = [](const auto& d, std::size_t x) { return x >= d.min and x <= d.max; };
+        if(as.type() != s.type() or as.dynamic() or as.ndim() != dd.size() or
+           not std::equal(dd.begin(), dd.end(), as.lens().begin(), in_range))
+        {
+            MIGRAPHX_THROW("Incorrect shape {" + to_string(as) + "} for parameter: " + name +
+                           " should be: " + to_string(s));
+        }
+        shapes.emplace(name, as);
+    }
+    return impl->get(shapes, false);
+}
+
+void specialization_cache::precompile_optimals() const
+{
+    wait();
+    auto* self       = impl.get();
+    self->stopped    = false;
+    self->background = std::thread([self] {
+        for(const auto& shapes : self->optimal_shapes())
+        {
+            if(self->stopped)
+                return;
+            try
+            {
+                self->get(shapes, true);
+            }
+            catch(...)
+            {
+                // The error is reported again when the shapes are used by an eval
+            }
+        }
+    });
+}
+
+void specialization_cache::wait() const
+{
+    if(impl->background.joinable())
+        impl->background.join();
+}
+
+specialization_cache::statistics specialization_cache::get_statistics() const
+{
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    auto result = impl->stats;
+    result.size = impl->items.size();
+    return result;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
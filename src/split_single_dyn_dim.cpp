@@ -29,6 +29,8 @@
 #include <migraphx/make_op.hpp>
 #include <migraphx/ranges.hpp>
 #include <migraphx/matcher.hpp>
+#include <migraphx/op/select_module.hpp>
+#include <map>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -125,9 +127,26 @@ void split_single_dyn_dim::apply(module_pass_manager& mpm) const
     {
         // all dynamic dimension objects should be the same for all parameters in dd_check_vec
         auto dyn_dim = dd_check_vec->at(0).dd;
-        // create submodules for each dimension size
-        std::vector<module_ref> submodules;
-        for(size_t dim_size : migraphx::range(dyn_dim.min, dyn_dim.max + 1))
+        // create submodules for each dimension size, or only for the optimals and the max when
+        // bucketing
+        std::vector<std::size_t> dim_sizes;
+        if(bucketing and not dyn_dim.optimals.empty())
+        {
+            std::copy_if(dyn_dim.optimals.begin(),
+                         dyn_dim.optimals.end(),
+                         std::back_inserter(dim_sizes),
+                         [&](auto x) { return x >= dyn_dim.min and x < dyn_dim.max; });
+            dim_sizes.push_back(dyn_dim.max);
+        }
+        else
+        {
+            auto r = migraphx::range(dyn_dim.min, dyn_dim.max + 1);
+            dim_sizes.assign(r.begin(), r.end());
+        }
+        // sort parameters by name for consistency (vs. parameter order attr)
+        std::sort(param_names.begin(), param_names.end());
+        std::map<std::size_t, module_ref> submodules;
+        for(size_t dim_size : dim_sizes)
         {
             auto* submod = mpm.create_module("dim_" + std::to_string(dim_size));
             // instruction map for new static shaped submodule parameters
@@ -142,10 +161,71 @@ void split_single_dyn_dim::apply(module_pass_manager& mpm) const
             }
             auto outputs = submod->add_instructions(mm, &map_ins);
             submod->add_return({outputs});
-            submodules.push_back(submod);
+            submodules[dim_size] = submod;
+        }
+        // the other sizes pad their inputs up to the next bigger submodule, run it and slice its
+        // outputs back
+        for(auto dim_size : range(dyn_dim.min, dyn_dim.max + 1))
+        {
+            if(contains(submodules, dim_size))
+                continue;
+            auto* bucket = submodules.upper_bound(dim_size)->second;
+            auto* submod = mpm.create_module("dim_" + std::to_string(dim_size));
+            std::vector<instruction_ref> bucket_inputs;
+            std::vector<shape> exact_inputs;
+            for(const auto& pn : param_names)
+            {
+                auto ps = mm->get_parameter_shape(pn);
+                if(not ps.dynamic())
+                {
+                    bucket_inputs.push_back(submod->add_parameter(pn, ps));
+                    exact_inputs.push_back(ps);
+                    continue;
+                }
+                auto s = ps.to_static(dim_size);
+                exact_inputs.push_back(s);
+                auto bps = bucket->get_parameter_shape(pn);
+                std::vector<int64_t> pads(2 * s.ndim(), 0);
+                std::transform(s.lens().begin(),
+                               s.lens().end(),
+                               bps.lens().begin(),
+                               pads.begin() + s.ndim(),
+                               [](auto len, auto bucket_len) { return bucket_len - len; });
+                bucket_inputs.push_back(
+                    submod->add_instruction(make_op("pad", {{"pads", pads}, {"value", pad_value}}),
+                                            submod->add_parameter(pn, s)));
+            }
+            auto bucket_ins =
+                submod->add_instruction(op::select_module{shape{bucket->get_output_shapes()}},
+                                        bucket_inputs,
+                                        {bucket});
+            // the output shapes for the exact size say what to slice
+            auto exact_shapes = mm->compute_shapes(exact_inputs);
+            std::vector<instruction_ref> outputs(exact_shapes.size());
+            for(size_t i = 0; i < exact_shapes.size(); ++i)
+            {
+                outputs.at(i) = submod->add_instruction(
+                    make_op("get_tuple_elem", {{"index", i}}), bucket_ins);
+                const auto& lens = outputs.at(i)->get_shape().lens();
+                std::vector<int64_t> axes;
+                std::vector<int64_t> ends;
+                for(size_t d = 0; d < lens.size(); ++d)
+                {
+                    if(lens[d] == exact_shapes[i].lens()[d])
+                        continue;
+                    axes.push_back(d);
+                    ends.push_back(exact_shapes[i].lens()[d]);
+                }
+                if(axes.empty())
+                    continue;
+                std::vector<int64_t> starts(axes.size(), 0);
+                outputs.at(i) = submod->add_instruction(
+                    make_op("slice", {{"axes", axes}, {"starts", starts}, {"ends", ends}}),
+                    outputs.at(i));
+            }
+            submod->add_return(outputs);
+            submodules[dim_size] = submod;
         }
-        // sort parameters by name for consistency (vs. parameter order attr)
-        std::sort(param_names.begin(), param_names.end());
         // redirect to select_module operator and return
         std::vector<instruction_ref> sm_inputs;
         std::transform(param_names.cbegin(),
@@ -154,11 +234,13 @@ void split_single_dyn_dim::apply(module_pass_manager& mpm) const
                        [&](auto pn) { return mm->get_parameter(pn); });
         auto output_shapes       = mm->get_output_shapes();
         migraphx::shape out_attr = migraphx::shape{output_shapes};
-        auto sm_ins              = mm->add_instruction(
-            migraphx::make_op("select_module",
-                              {{"output_dyn_shapes", migraphx::to_value(out_attr)}}),
-            sm_inputs,
-            submodules);
+        op::select_module sm{out_attr};
+        std::vector<module_ref> sm_submodules;
+        std::transform(submodules.begin(),
+                       submodules.end(),
+                       std::back_inserter(sm_submodules),
+                       [](const auto& p) { return p.second; });
+        auto sm_ins = mm->add_instruction(sm, sm_inputs, sm_submodules);
         std::vector<instruction_ref> outputs(output_shapes.size());
         for(size_t i = 0; i < output_shapes.size(); ++i)
         {
@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  */
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/env.hpp>
 
 #if defined(__GNUC__) && __GNUC__ <= 5
 namespace std {
@@ -47,6 +49,13 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DNNL_PRIMITIVE_CACHE_SIZE);
+
+std::size_t dnnl_primitive_cache_size()
+{
+    return value_of(MIGRAPHX_DNNL_PRIMITIVE_CACHE_SIZE{}, 1024);
+}
+
 dnnl_context& get_dnnl_context()
 {
     static dnnl_context ctx{}; // NOLINT
@@ -105,6 +114,15 @@ dnnl::memory to_dnnl_memory(const argument& a)
     return to_dnnl_memory(to_dnnl_memory_desc(a.get_shape()), a);
 }
 
+dnnl::memory reorder_memory(const dnnl::memory& src, const dnnl::memory::desc& desc)
+{
+    auto& ctx = get_dnnl_context();
+    dnnl::memory dst{desc, ctx.engine};
+    dnnl::reorder{src, dst}.execute(ctx.stream, src, dst);
+    ctx.stream.wait();
+    return dst;
+}
+
 // clang-format off
 #define MIGRAPHX_VISIT_DNNL_ALGO(m) \
         m(undef) \
@@ -176,6 +194,11 @@ const std::unordered_map<std::string, dnnl::algorithm>& dnnl_algo_map()
     return m;
 }
 
+bool dnnl_exhaustive_tune(migraphx::context& ctx)
+{
+    return any_cast<cpu::context>(ctx).exhaustive_tune;
+}
+
 dnnl::algorithm to_dnnl_algo(const std::string& name)
 {
     if(dnnl_algo_map().count(name) == 0)
@@ -0,0 +1,361 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/fused_reduce.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/builtin.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/copy_layout.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/simple_par_for.hpp>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <utility>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+static bool is_pointwise_module(const module& pm)
+{
+    if(pm.get_output_shapes().size() != 1)
+        return false;
+    return std::all_of(pm.begin(), pm.end(), [](const instruction& ins) {
+        return contains({"@param", "@literal", "@return"}, ins.name()) or
+               ins.get_operator().attributes().contains("pointwise");
+    });
+}
+
+bool is_fusable_reduce_module(const module& m, const std::vector<std::int64_t>& axes)
+{
+    if(axes.empty() or m.get_output_shapes().size() != 1)
+        return false;
+    // The blocks are views with the output's axes, so every input must have its rank
+    auto rank = m.get_output_shapes().front().ndim();
+    return std::all_of(m.begin(), m.end(), [&](const instruction& ins) {
+        if(ins.name() == "@return")
+            return true;
+        if(ins.get_shape().dynamic() or ins.get_shape().ndim() != rank)
+            return false;
+        if(contains({"@param", "multibroadcast"}, ins.name()))
+            return true;
+        if(ins.name() == "pointwise")
+            return is_pointwise_module(*ins.module_inputs().front());
+        if(ins.get_operator().attributes().contains("reduce"))
+            return ins.get_operator().to_value()["axes"].to_vector<std::int64_t>() == axes;
+        return false;
+    });
+}
+
+// Add the instructions of the pointwise module of ins to m, with its scalar literals broadcast
+// to the lens of the inputs
+static instruction_ref
+insert_pointwise(module& m, instruction_ref ins, const std::vector<instruction_ref>& inputs)
+{
+    const auto* pm = ins->module_inputs().front();
+    auto lens      = inputs.front()->get_shape().lens();
+    auto map_ins   = pm->get_ins_param_map(inputs, true);
+    instruction_ref result;
+    for(auto pins : iterator_for(*pm))
+    {
+        if(pins->name() == "@param")
+            continue;
+        if(pins->name() == "@return")
+            return map_ins.at(pins->inputs().front());
+        if(pins->name() == "@literal")
+        {
+            auto l        = m.add_literal(pins->get_literal());
+            map_ins[pins] = m.add_instruction(make_op("multibroadcast", {{"out_lens", lens}}), l);
+        }
+        else
+        {
+            std::vector<instruction_ref> pinputs;
+            std::transform(pins->inputs().begin(),
+                           pins->inputs().end(),
+                           std::back_inserter(pinputs),
+                           [&](auto i) { return map_ins.at(i); });
+            map_ins[pins] = m.add_instruction(pins->get_operator(), pinputs);
+        }
+        result = map_ins[pins];
+    }
+    return result;
+}
+
+/**
+ * The instructions of the submodule flattened into a module that computes one block of the
+ * output, where the lens of every parameter and broadcast are given by block_lens. The
+ * pointwise modules are inlined so the whole block can be computed op by op.
+ */
+template <class F>
+static module make_block_module(const module& m, F block_lens)
+{
+    module result;
+    std::unordered_map<instruction_ref, instruction_ref> map_ins;
+    for(auto ins : iterator_for(m))
+    {
+        std::vector<instruction_ref> inputs;
+        std::transform(ins->inputs().begin(),
+                       ins->inputs().end(),
+                       std::back_inserter(inputs),
+                       [&](auto i) { return map_ins.at(i); });
+        const auto& s = ins->get_shape();
+        if(ins->name() == "@param")
+        {
+            auto name    = any_cast<builtin::param>(ins->get_operator()).parameter;
+            map_ins[ins] = result.add_parameter(name, shape{s.type(), block_lens(s.lens())});
+        }
+        else if(ins->name() == "@return")
+        {
+            result.add_return(inputs);
+        }
+        else if(ins->name() == "pointwise")
+        {
+            map_ins[ins] = insert_pointwise(result, ins, inputs);
+        }
+        else if(ins->name() == "multibroadcast")
+        {
+            map_ins[ins] = result.add_instruction(
+                make_op("multibroadcast", {{"out_lens", block_lens(s.lens())}}), inputs);
+        }
+        else
+        {
+            map_ins[ins] = result.add_instruction(ins->get_operator(), inputs);
+        }
+    }
+    return result;
+}
+
+static argument eval_block(const module& m,
+                           const std::unordered_map<std::string, argument>& params)
+{
+    std::unordered_map<instruction_ref, argument> results;
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() == "@param")
+        {
+            results[ins] = params.at(any_cast<builtin::param>(ins->get_operator()).parameter);
+        }
+        else if(ins->name() == "@literal")
+        {
+            results[ins] = ins->get_literal().get_argument();
+        }
+        else if(ins->name() == "@return")
+        {
+            return results.at(ins->inputs().front());
+        }
+        else
+        {
+            std::vector<argument> args;
+            std::transform(ins->inputs().begin(),
+                           ins->inputs().end(),
+                           std::back_inserter(args),
+                           [&](auto i) { return results.at(i); });
+            results[ins] = ins->get_operator().compute(ins->get_shape(), args);
+        }
+    }
+    return results.at(std::prev(m.end()));
+}
+
+/**
+ * Fused reductions are computed a block at a time: the output is split along one of the axes
+ * before the first reduced axis, and every block is computed with the submodule flattened to
+ * the lens of a block. The intermediate results of a block stay in cache instead of being
+ * written out for the whole tensor between each op, and the blocks are computed in parallel.
+ */
+struct cpu_fused_reduce : auto_register_op<cpu_fused_reduce>
+{
+    std::vector<std::int64_t> axes{};
+
+    // The block modules of each split axis and block length, which are made on the first call
+    struct block_modules
+    {
+        std::mutex mutex;
+        std::map<std::pair<std::size_t, std::size_t>, module> modules;
+
+        const module& get(const module& m, std::size_t axis, std::size_t len)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto key = std::make_pair(axis, len);
+            auto it  = modules.find(key);
+            if(it == modules.end())
+            {
+                it = modules
+                         .emplace(key, make_block_module(m, [&](std::vector<std::size_t> lens) {
+                             std::fill(lens.begin(), lens.begin() + axis, 1);
+                             if(lens[axis] != 1)
+                                 lens[axis] = len;
+                             return lens;
+                         }))
+                         .first;
+            }
+            return it->second;
+        }
+    };
+    std::shared_ptr<block_modules> blocks = nullptr;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.axes, "axes"));
+    }
+
+    std::string name() const { return "cpu::fused_reduce"; }
+
+    shape compute_shape(const std::vector<shape>& inputs, std::vector<module_ref> mods) const
+    {
+        if(mods.size() != 1)
+            MIGRAPHX_THROW("should have one submodule.");
+        // Compensate for allocation
+        check_shapes{inputs, *this}.has(mods.front()->get_parameter_names().size() + 1);
+        return inputs.back();
+    }
+
+    void finalize(context&, const shape&, const std::vector<shape>&)
+    {
+        blocks = std::make_shared<block_modules>();
+    }
+
+    argument compute(context& ctx,
+                     const shape& output_shape,
+                     const std::vector<argument>& args,
+                     const std::vector<module_ref>& mods,
+                     const std::function<std::vector<argument>(
+                         module_ref&, const std::unordered_map<std::string, argument>&)>&) const
+    {
+        // Number of elements in the intermediate results of a block
+        const std::size_t block_elements = 16384;
+        const auto* sm                   = mods.front();
+        auto names                       = sm->get_parameter_names();
+        std::sort(names.begin(), names.end());
+
+        // The lens of the computation, which include the reduced axes
+        auto lens = output_shape.lens();
+        std::for_each(args.begin(), args.end() - 1, [&](const argument& arg) {
+            const auto& alens = arg.get_shape().lens();
+            std::transform(lens.begin(),
+                           lens.end(),
+                           alens.begin(),
+                           lens.begin(),
+                           [](auto x, auto y) { return std::max(x, y); });
+        });
+        auto inner_elements = [&](std::size_t axis) {
+            return std::accumulate(
+                lens.begin() + axis + 1, lens.end(), std::size_t{1}, std::multiplies<>{});
+        };
+
+        // Split along the outermost axis before the reduced axes whose inner elements fit in a
+        // block, or compute everything at once when the first axis is reduced
+        auto first_reduced = static_cast<std::size_t>(*std::min_element(axes.begin(), axes.end()));
+        std::size_t axis   = 0;
+        std::size_t len    = lens.front();
+        if(first_reduced > 0)
+        {
+            axis = first_reduced - 1;
+            for(std::size_t d = 0; d < first_reduced; d++)
+            {
+                if(inner_elements(d) <= block_elements)
+                {
+                    axis = d;
+                    break;
+                }
+            }
+            auto outer = std::accumulate(
+                lens.begin(), lens.begin() + axis, std::size_t{1}, std::multiplies<>{});
+            // Keep enough blocks to use every thread
+            len = std::min(block_elements / inner_elements(axis),
+                           outer * lens[axis] / std::max<std::size_t>(1, max_threads()));
+            len = std::max<std::size_t>(1, std::min(len, lens[axis]));
+        }
+        auto nblocks = (lens[axis] + len - 1) / len;
+        auto nouter  = std::accumulate(
+            lens.begin(), lens.begin() + axis, std::size_t{1}, std::multiplies<>{});
+
+        // A view of a block of arg, where outer is the index of the axes before the split
+        auto block_view = [&](const argument& arg,
+                              std::size_t outer,
+                              std::size_t start,
+                              std::size_t n) {
+            const auto& s      = arg.get_shape();
+            auto blens         = s.lens();
+            std::size_t offset = 0;
+            for(std::size_t d = axis; d > 0; d--)
+            {
+                auto i = outer % lens[d - 1];
+                outer /= lens[d - 1];
+                if(blens[d - 1] != 1)
+                    offset += i * s.strides()[d - 1];
+                blens[d - 1] = 1;
+            }
+            if(blens[axis] != 1)
+            {
+                offset += start * s.strides()[axis];
+                blens[axis] = n;
+            }
+            return argument{shape{s.type(), blens, s.strides()},
+                            arg.data() + offset * s.type_size()};
+        };
+
+        auto cache  = blocks == nullptr ? std::make_shared<block_modules>() : blocks;
+        auto output = args.back();
+        ctx.bulk_execute(nouter * nblocks, 1, [&](auto first, auto last) {
+            // The blocks already run in parallel, so reduce within a block serially
+            serial_par_for_scope serial{};
+            for(auto i = first; i < last; i++)
+            {
+                auto outer = i / nblocks;
+                auto start = (i % nblocks) * len;
+                auto n     = std::min(len, lens[axis] - start);
+                std::unordered_map<std::string, argument> params;
+                std::transform(names.begin(),
+                               names.end(),
+                               args.begin(),
+                               std::inserter(params, params.end()),
+                               [&](const auto& pname, const auto& arg) {
+                                   return std::make_pair(pname, block_view(arg, outer, start, n));
+                               });
+                auto result = eval_block(cache->get(*sm, axis, n), params);
+                visit_all(block_view(output, outer, start, n), result)(
+                    [&](auto out, auto x) { copy_layout(out, x); });
+            }
+        });
+        return output;
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
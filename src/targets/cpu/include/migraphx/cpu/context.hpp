@@ -36,6 +36,9 @@ namespace cpu {
 
 struct context
 {
+    // Benchmark the dnnl implementations of each problem, and save the fastest in the tuning db
+    bool exhaustive_tune = false;
+
     void finish() const {}
 
     template <class F>
@@ -29,6 +29,17 @@
 #include <migraphx/reflect.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/check_shapes.hpp>
+#include <migraphx/cpu/tuning_db.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/serialize.hpp>
+#include <migraphx/time.hpp>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <unordered_map>
 #include <migraphx/errors.hpp>
 #include <migraphx/assert.hpp>
@@ -50,11 +61,86 @@ namespace dnnl = zendnn;
 #endif
 #define MIGRAPHX_DNNL_PREFIX(b) MIGRAPHX_CONCAT_PREFIX(b) // NOLINT
 
+/**
+ * Least recently used cache of dnnl primitives, keyed by the op and the shapes it runs on. The
+ * primitives are shared by every instruction with the same problem, and let ops with dynamic
+ * shapes avoid creating a primitive on every call.
+ */
+struct dnnl_primitive_cache
+{
+    struct entry
+    {
+        dnnl::primitive prim;
+        // Memory descriptors the primitive was created with
+        std::unordered_map<int, dnnl::memory::desc> md;
+    };
+
+    explicit dnnl_primitive_cache(std::size_t n) : capacity(n) {}
+
+    // Return the entry for key, calling create to make it when it is not in the cache
+    template <class F>
+    entry get(const std::string& key, F create)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = lookup.find(key);
+            if(it != lookup.end())
+            {
+                items.splice(items.begin(), items, it->second);
+                return it->second->second;
+            }
+        }
+        entry e = create();
+        std::lock_guard<std::mutex> lock(mutex);
+        if(lookup.count(key) == 0)
+        {
+            items.emplace_front(key, e);
+            lookup[key] = items.begin();
+            if(items.size() > capacity)
+            {
+                lookup.erase(items.back().first);
+                items.pop_back();
+            }
+        }
+        return e;
+    }
+
+    void erase(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = lookup.find(key);
+        if(it == lookup.end())
+            return;
+        items.erase(it->second);
+        lookup.erase(it);
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+    }
+
+    private:
+    std::size_t capacity;
+    mutable std::mutex mutex;
+    std::list<std::pair<std::string, entry>> items;
+    std::unordered_map<std::string, std::list<std::pair<std::string, entry>>::iterator> lookup;
+};
+
+std::size_t dnnl_primitive_cache_size();
+
 struct dnnl_context
 {
     dnnl::engine engine;
     dnnl::stream stream;
-    dnnl_context() : engine(dnnl::engine::kind::cpu, 0), stream(engine) {}
+    dnnl_primitive_cache primitives;
+    dnnl_context()
+        : engine(dnnl::engine::kind::cpu, 0),
+          stream(engine),
+          primitives(dnnl_primitive_cache_size())
+    {
+    }
 };
 
 dnnl_context& get_dnnl_context();
@@ -77,6 +163,9 @@ dnnl::memory to_dnnl_memory(const argument& a);
 
 dnnl::algorithm to_dnnl_algo(const std::string& name);
 
+// Whether the dnnl implementations should be tuned, which is set from compile_options
+bool dnnl_exhaustive_tune(migraphx::context& ctx);
+
 std::string to_string(const dnnl::algorithm& algo);
 
 struct post_op : reflect_equality<post_op>, reflect_stream<post_op>
@@ -91,6 +180,15 @@ struct post_op : reflect_equality<post_op>, reflect_stream<post_op>
     }
 };
 
+// Constant inputs of a dnnl op after they have been reordered to the layout of the primitive
+struct prepacked_memory
+{
+    std::once_flag flag;
+    std::unordered_map<int, dnnl::memory> memory;
+};
+
+dnnl::memory reorder_memory(const dnnl::memory& src, const dnnl::memory::desc& desc);
+
 template <class F>
 struct execute_wrapper
 {
@@ -108,12 +206,15 @@ template <class Derived, class Primitive>
 struct dnnl_op : auto_register_op<Derived>
 {
     std::vector<post_op> post_ops;
+    // Inputs that are constant, so they can be reordered once into the layout the primitive
+    // prefers instead of being passed in the plain layout on every call
+    std::vector<std::size_t> prepack;
     std::function<argument(context& ctx, const std::vector<argument>& args)> execute;
 
     template <class Self, class F>
     static auto reflect_base(Self& self, F f)
     {
-        return pack(f(self.post_ops, "post_ops"));
+        return pack(f(self.post_ops, "post_ops"), f(self.prepack, "prepack"));
     }
 
     template <class Self, class F>
@@ -162,7 +263,7 @@ struct dnnl_op : auto_register_op<Derived>
         });
         return shapes;
     }
-    static std::string impl(const Primitive& prim)
+    static std::string impl(const dnnl::primitive& prim)
     {
         auto desc       = prim.get_primitive_desc();
         const char* str = nullptr;
@@ -282,13 +383,137 @@ struct dnnl_op : auto_register_op<Derived>
     {
         return typename Primitive::primitive_desc(desc, attr, get_dnnl_context().engine);
     }
-    Primitive get_primitive(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    auto make_primitive_desc(const std::unordered_map<int, dnnl::memory::desc>& m) const
     {
         const auto& self = static_cast<const Derived&>(*this);
         auto desc        = self.get_desc(m);
         auto attr        = MIGRAPHX_ASSERT_NO_THROW(this->get_primitive_attr(m));
-        auto pd          = self.get_primitive_desc(desc, attr);
-        return Primitive(pd);
+        return self.get_primitive_desc(desc, attr);
+    }
+    Primitive get_primitive(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    {
+        return Primitive(make_primitive_desc(m));
+    }
+    std::string problem_key(const shape& output_shape, const std::vector<shape>& inputs) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        std::stringstream ss;
+        ss << self.name() << to_json_string(migraphx::to_value(self)) << output_shape;
+        for(const auto& s : inputs)
+            ss << "," << s;
+        return ss.str();
+    }
+    dnnl_primitive_cache::entry get_cached_primitive(const shape& output_shape,
+                                                     const std::vector<shape>& inputs) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        auto key         = problem_key(output_shape, inputs);
+        return get_dnnl_context().primitives.get(key, [&] {
+            auto md         = to_memory_desc(output_shape, inputs);
+            auto arg_lookup = create_arg_map(inputs.size());
+            auto solution   = get_tuning_db().get(self.name(), key);
+            if(solution.has_value())
+            {
+                auto pd = make_tuned_primitive_desc(
+                    md, arg_lookup, solution->at("impl").to<std::size_t>());
+                Primitive prim{pd};
+                // Another version of dnnl can list its implementations in a different order, so
+                // the tuned one is only used when it still has the same name
+                if(impl(prim) == solution->get("name", std::string{}))
+                    return dnnl_primitive_cache::entry{
+                        prim, to_prepacked_memory_desc(pd, md, arg_lookup)};
+            }
+            auto pd = make_tuned_primitive_desc(md, arg_lookup, 0);
+            return dnnl_primitive_cache::entry{Primitive(pd),
+                                               to_prepacked_memory_desc(pd, md, arg_lookup)};
+        });
+    }
+    // Time every implementation dnnl has for the problem, and record the fastest in the tuning db
+    void tune(const shape& output_shape, const std::vector<shape>& inputs) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        auto key         = problem_key(output_shape, inputs);
+        if(get_tuning_db().get(self.name(), key).has_value())
+            return;
+        auto& ctx        = get_dnnl_context();
+        auto md          = to_memory_desc(output_shape, inputs);
+        auto arg_lookup  = create_arg_map(inputs.size());
+        auto pd          = make_tuned_primitive_desc(md, arg_lookup, 0);
+        std::size_t best = 0;
+        std::string best_name;
+        double best_time = std::numeric_limits<double>::max();
+        for(std::size_t n = 0;; n++)
+        {
+            std::unordered_map<int, dnnl::memory> m;
+            for(auto&& p : to_prepacked_memory_desc(pd, md, arg_lookup))
+            {
+                m[p.first] = dnnl::memory{p.second, ctx.engine};
+                std::memset(m[p.first].get_data_handle(), 0, p.second.get_size());
+            }
+            Primitive prim{pd};
+            auto run = [&] {
+                prim.execute(ctx.stream, m);
+                ctx.stream.wait();
+            };
+            run();
+            auto t = time<std::chrono::duration<double, std::micro>>([&] {
+                for(int i = 0; i < 10; i++)
+                    run();
+            });
+            if(t < best_time)
+            {
+                best      = n;
+                best_name = impl(prim);
+                best_time = t;
+            }
+            if(not pd.next_impl())
+                break;
+        }
+        get_tuning_db().insert(self.name(), key, {{"impl", best}, {"name", best_name}});
+        ctx.primitives.erase(key);
+    }
+    // The output shape for the static input shapes of a call, used when the shapes are dynamic
+    shape compute_output_shape(const std::vector<shape>&) const
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        MIGRAPHX_THROW(self.name() + ": dynamic shapes are not supported");
+    }
+    // The primitive descriptor of the impl-th implementation for the problem. The prepacked
+    // inputs are left with the format any, so the implementation picks their layout.
+    auto make_tuned_primitive_desc(const std::unordered_map<int, dnnl::memory::desc>& md,
+                                   const std::vector<int>& arg_lookup,
+                                   std::size_t impl) const
+    {
+        auto result = md;
+        for(auto i : prepack)
+        {
+            auto arg    = arg_lookup.at(i);
+            result[arg] = dnnl::memory::desc{
+                md.at(arg).dims(), md.at(arg).data_type(), dnnl::memory::format_tag::any};
+        }
+        auto pd = make_primitive_desc(result);
+        for(std::size_t i = 0; i < impl; i++)
+        {
+            if(not pd.next_impl())
+                break;
+        }
+        return pd;
+    }
+    // The memory descriptors for a primitive descriptor from make_tuned_primitive_desc, with the
+    // layouts it picked for the prepacked inputs
+    template <class PrimitiveDesc>
+    std::unordered_map<int, dnnl::memory::desc>
+    to_prepacked_memory_desc(const PrimitiveDesc& pd,
+                             const std::unordered_map<int, dnnl::memory::desc>& md,
+                             const std::vector<int>& arg_lookup) const
+    {
+        auto result = md;
+        for(auto i : prepack)
+        {
+            auto arg    = arg_lookup.at(i);
+            result[arg] = pd.query_md(dnnl::query::exec_arg_md, arg);
+        }
+        return result;
     }
     argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
     {
@@ -303,21 +528,39 @@ struct dnnl_op : auto_register_op<Derived>
     {
         // Compensate for allocation
         inputs.pop_back();
-        auto md        = to_memory_desc(output_shape, inputs);
-        auto prim      = get_primitive(md);
-        auto impl_name = impl(prim);
-        return {{"impl", impl_name}};
+        if(output_shape.dynamic())
+            return {};
+        // The primitive the op runs with, which is the tuned one with the prepacked layouts
+        auto entry = get_cached_primitive(output_shape, inputs);
+        return {{"impl", impl(entry.prim)}};
     }
 
-    void finalize(context&, const shape& output_shape, std::vector<shape> inputs)
+    void finalize(context& ctx, const shape& output_shape, std::vector<shape> inputs)
     {
         // Compensate for allocation
         inputs.pop_back();
+        if(not output_shape.dynamic() and dnnl_exhaustive_tune(ctx))
+            tune(output_shape, inputs);
         const auto& self = static_cast<const Derived&>(*this);
         auto name        = self.name();
-        auto md          = to_memory_desc(output_shape, inputs);
-        auto prim        = get_primitive(md);
         auto arg_lookup  = create_arg_map(inputs.size());
+        if(output_shape.dynamic())
+        {
+            finalize_dynamic(arg_lookup);
+            return;
+        }
+        auto md    = to_memory_desc(output_shape, inputs);
+        auto entry = get_cached_primitive(output_shape, inputs);
+        auto pmd   = entry.md;
+        auto prim  = entry.prim;
+        // The reordered constant inputs, filled in on the first call
+        std::vector<int> packed_args;
+        for(auto i : prepack)
+        {
+            if(pmd.at(arg_lookup.at(i)) != md.at(arg_lookup.at(i)))
+                packed_args.push_back(arg_lookup.at(i));
+        }
+        auto packed = std::make_shared<prepacked_memory>();
 #ifndef NDEBUG
         auto prim_attr = get_primitive_attr(md);
 #endif
@@ -390,10 +633,44 @@ struct dnnl_op : auto_register_op<Derived>
                 to_dnnl_memory(md.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)), args.back());
             for(int i = 0; i < args.size() - 1; i++)
                 m[arg_lookup[i]] = to_dnnl_memory(md.at(arg_lookup[i]), args[i]);
+            if(not packed_args.empty())
+            {
+                std::call_once(packed->flag, [&] {
+                    for(auto arg : packed_args)
+                        packed->memory[arg] = reorder_memory(m.at(arg), pmd.at(arg));
+                });
+                for(auto arg : packed_args)
+                    m[arg] = packed->memory.at(arg);
+            }
             prim.execute(get_dnnl_context().stream, m);
             return args.back();
         });
     }
+    // The shapes are only known when the op is called, so the primitive is looked up in the
+    // cache on every call
+    void finalize_dynamic(const std::vector<int>& arg_lookup)
+    {
+        auto self = static_cast<const Derived&>(*this);
+        execute   = make_execute_wrapper([=](const std::vector<argument>& args) {
+            auto inputs = to_shapes(args);
+            inputs.pop_back();
+            auto output_shape = self.compute_output_shape(inputs);
+            auto entry        = self.get_cached_primitive(output_shape, inputs);
+            // The allocation is sized for the largest shape, so it is reused when it fits
+            auto result = args.back();
+            if(result.data() == nullptr or result.get_shape().bytes() < output_shape.bytes())
+                result = argument{output_shape};
+            else
+                result = result.reshape(output_shape);
+            std::unordered_map<int, dnnl::memory> m;
+            m[MIGRAPHX_DNNL_PREFIX(ARG_DST)] =
+                to_dnnl_memory(entry.md.at(MIGRAPHX_DNNL_PREFIX(ARG_DST)), result);
+            for(int i = 0; i < args.size() - 1; i++)
+                m[arg_lookup[i]] = to_dnnl_memory(entry.md.at(arg_lookup[i]), args[i]);
+            entry.prim.execute(get_dnnl_context().stream, m);
+            return result;
+        });
+    }
     std::vector<shape> trim_post_op_inputs(const std::vector<shape>& inputs) const
     {
         auto prim_input_size = inputs.size() - this->get_extra_post_op_args();
@@ -425,12 +702,18 @@ struct dnnl_extend_op : dnnl_op<Derived, Primitive>
         const auto& self = static_cast<const Derived&>(*this);
         // Compensate for allocation
         inputs.pop_back();
+        if(std::any_of(inputs.begin(), inputs.end(), [](const shape& s) { return s.dynamic(); }))
+            return compute_output_shape(inputs);
         self.required(check_shapes(inputs, self));
-        auto r = migraphx::compute_shape(op, this->trim_post_op_inputs(inputs));
-        // Call to get_primitive to make sure an algo is available
-        this->get_primitive(this->to_memory_desc(r, inputs));
+        auto r = compute_output_shape(inputs);
+        // Call to get_cached_primitive to make sure an algo is available
+        this->get_cached_primitive(r, inputs);
         return r;
     }
+    shape compute_output_shape(const std::vector<shape>& inputs) const
+    {
+        return migraphx::compute_shape(op, this->trim_post_op_inputs(inputs));
+    }
 };
 
 } // namespace cpu
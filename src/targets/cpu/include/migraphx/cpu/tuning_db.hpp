@@ -0,0 +1,69 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MIGRAPHX_GUARD_CPU_TUNING_DB_HPP
+#define MIGRAPHX_GUARD_CPU_TUNING_DB_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/cpu/export.h>
+#include <migraphx/filesystem.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/value.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+/**
+ * Persistent database of the solutions picked by tuning, stored with sqlite. Solutions are keyed
+ * by the name of the op, the problem and the model of the host cpu, so a database shared by
+ * different machines keeps a solution for each of them.
+ */
+struct MIGRAPHX_CPU_EXPORT tuning_db
+{
+    tuning_db() = default;
+    explicit tuning_db(fs::path p, std::string cpu_model = get_cpu_model());
+
+    optional<value> get(const std::string& name, const value& problem) const;
+    void insert(const std::string& name, const value& problem, const value& solution);
+
+    /// The model name of the host cpu from /proc/cpuinfo
+    static std::string get_cpu_model();
+
+    private:
+    fs::path path;
+    std::string cpu;
+    mutable std::mutex mutex;
+    mutable std::unordered_map<std::string, optional<value>> cache;
+};
+
+/// The database at MIGRAPHX_CPU_TUNING_DB, or in the temporary directory when it is not set
+MIGRAPHX_CPU_EXPORT tuning_db& get_tuning_db();
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_CPU_TUNING_DB_HPP
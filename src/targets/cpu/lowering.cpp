@@ -23,7 +23,12 @@
  */
 
 #include <migraphx/cpu/lowering.hpp>
+#include <migraphx/cpu/fused_reduce.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/fuse_pointwise.hpp>
+#include <migraphx/fuse_reduce.hpp>
 #include <migraphx/instruction.hpp>
+#include <migraphx/pass_manager.hpp>
 #include <migraphx/dfor.hpp>
 #include <migraphx/op/identity.hpp>
 #include <migraphx/op/convolution.hpp>
@@ -58,6 +63,7 @@
 #include <migraphx/match/gelu_tanh.hpp>
 #include <migraphx/matcher.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <iostream>
 
@@ -266,6 +272,8 @@ struct cpu_apply
 {
     module* modl;
     std::unordered_map<std::string, std::function<instruction_ref(instruction_ref)>> apply_map{};
+    // Ops whose cpu version can run on shapes only known at run time
+    std::unordered_set<std::string> dynamic_ops{};
     instruction_ref last{};
 
     void extend_op(const std::string& op_name, const std::string& cpu_name, bool allocate = true)
@@ -301,6 +309,8 @@ struct cpu_apply
     {
         return match::make_match_finder(matcher, [=](auto&, const auto& r) {
             auto ins = r.result;
+            if(ins->get_shape().dynamic())
+                return;
             std::vector<instruction_ref> inputs;
             std::transform(bind_inputs.begin(),
                            bind_inputs.end(),
@@ -340,6 +350,7 @@ struct cpu_apply
                               {"reduce_min", "reduction_min"},
                               {"reduce_sum", "reduction_sum"},
                           });
+        extend_op("attention", "cpu::attention");
         extend_op("concat", "dnnl::concat");
         extend_op("contiguous", "dnnl::reorder");
         extend_op("convolution", "dnnl::convolution");
@@ -349,20 +360,39 @@ struct cpu_apply
 #endif
         extend_op("erf", "cpu::erf");
         extend_op("gather", "cpu::gather");
+        extend_op("gru", "cpu::gru");
         extend_op("logsoftmax", "dnnl::logsoftmax");
         extend_op("lrn", "dnnl::lrn");
+        extend_op("lstm", "cpu::lstm");
         extend_op("softmax", "dnnl::softmax");
 
+        apply_map.emplace("fused_reduce", [=](instruction_ref ins) {
+            auto inputs = ins->inputs();
+            inputs.push_back(insert_allocation(ins, ins->get_shape()));
+            return modl->replace_instruction(
+                ins,
+                make_op("cpu::fused_reduce", ins->get_operator().to_value()),
+                inputs,
+                ins->module_inputs());
+        });
+
+        dynamic_ops = {"concat",
+                       "convolution",
+                       "convolution_backwards",
+                       "dot",
+                       "logsoftmax",
+                       "lrn",
+                       "pooling",
+                       "softmax"};
+
         extend_op("im2col", "cpu::im2col", false);
         extend_op("leaky_relu", "cpu::leaky_relu", false);
         extend_op("pad", "cpu::pad", false);
         extend_op("rnn_var_sl_last_output", "cpu::rnn_var_sl_last_output", false);
     }
 
-    void apply()
+    void apply_fusion_matchers()
     {
-        init();
-        // Apply fusion matchers first
         match::find_matches(*modl,
                             fuse_match(match::gelu_erf(),
                                        make_op("dnnl::eltwise", {{"algo", "eltwise_gelu_erf"}}),
@@ -371,6 +401,11 @@ struct cpu_apply
                                        make_op("dnnl::eltwise", {{"algo", "eltwise_gelu_tanh"}}),
                                        {"x"}),
                             fuse_match(match::layernorm(), make_op("dnnl::layernorm"), {"x"}));
+    }
+
+    void apply()
+    {
+        init();
         // Apply these operators first so the inputs can be const folded
         for(auto it : iterator_for(*modl))
         {
@@ -380,6 +415,8 @@ struct cpu_apply
                    return i->get_shape().type() == migraphx::shape::fp8e4m3fnuz_type;
                }))
                 continue;
+            if(it->get_shape().dynamic())
+                continue;
             if(it->name() == "pow")
             {
                 apply_pow(it);
@@ -393,10 +430,16 @@ struct cpu_apply
                    return i->get_shape().type() == migraphx::shape::fp8e4m3fnuz_type;
                }))
                 continue;
+            if(it->get_shape().dynamic() and not contains(dynamic_ops, it->name()))
+                continue;
             if(it->name() == "pooling")
             {
                 apply_pooling(it);
             }
+            else if(it->name() == "resize")
+            {
+                apply_resize(it);
+            }
             else if(apply_map.count(it->name()) > 0)
             {
                 apply_map.at(it->name())(it);
@@ -425,6 +468,14 @@ struct cpu_apply
         return ins;
     }
 
+    instruction_ref apply_resize(instruction_ref ins) const
+    {
+        // The output shape is only known at runtime when the sizes or scales are an input
+        if(ins->get_shape().dynamic() or ins->inputs().size() != 1)
+            return ins;
+        return replace(ins, make_op("cpu::resize", ins->get_operator().to_value()));
+    }
+
     template <class T>
     static std::vector<T> read_scalar(instruction_ref ins)
     {
@@ -456,7 +507,65 @@ struct cpu_apply
     }
 };
 
-void lowering::apply(module& m) const { cpu_apply{&m}.apply(); }
+static void inline_module(module& m, instruction_ref ins)
+{
+    const auto* sm = ins->module_inputs().front();
+    auto map_ins   = sm->get_ins_param_map(ins->inputs(), true);
+    // The literals of pointwise modules are scalars, so broadcast them to the output
+    for(auto sins : iterator_for(*sm))
+    {
+        if(sins->name() != "@literal" or not sins->get_shape().scalar())
+            continue;
+        map_ins[sins] = m.insert_instruction(
+            ins,
+            make_op("multibroadcast", {{"out_lens", ins->get_shape().lens()}}),
+            m.add_literal(sins->get_literal()));
+    }
+    auto results = m.insert_instructions(ins, sm, &map_ins);
+    m.replace_instruction(ins, results.front());
+}
+
+// Inline the fused reductions that cpu::fused_reduce can't run or that are only a reduction,
+// which is faster with dnnl, and then the pointwise modules left outside of a fused reduction
+static void inline_unfused_modules(module& m)
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "fused_reduce")
+            continue;
+        const auto* rm = ins->module_inputs().front();
+        auto axes      = ins->get_operator().to_value()["axes"].to_vector<std::int64_t>();
+        auto nops      = std::count_if(rm->begin(), rm->end(), [](const instruction& x) {
+            return not contains({"@param", "@return"}, x.name());
+        });
+        if(nops > 1 and is_fusable_reduce_module(*rm, axes))
+            continue;
+        inline_module(m, ins);
+    }
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() == "pointwise")
+            inline_module(m, ins);
+    }
+}
+
+void lowering::apply(module_pass_manager& mpm) const
+{
+    auto& m = mpm.get_module();
+    // Apply the dnnl fusion matchers first, so fuse_reduce doesn't take their reductions
+    cpu_apply{&m}.apply_fusion_matchers();
+    // The fused modules need shapes known at compile time
+    if(std::none_of(m.begin(), m.end(), [](const instruction& ins) {
+           return ins.get_shape().dynamic();
+       }))
+    {
+        mpm.run_pass(fuse_pointwise{.enable_rewrite_reshapes = false});
+        mpm.run_pass(fuse_reduce{.enable_rewrite_reshapes = false});
+        inline_unfused_modules(m);
+        mpm.run_pass(dead_code_elimination{});
+    }
+    cpu_apply{&m}.apply();
+}
 
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
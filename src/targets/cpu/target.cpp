@@ -33,7 +33,9 @@
 #include <migraphx/eliminate_identity.hpp>
 #include <migraphx/eliminate_pad.hpp>
 #include <migraphx/eliminate_convert.hpp>
+#include <migraphx/fuse_attention.hpp>
 #include <migraphx/layout_nhwc.hpp>
+#include <migraphx/inplace_allocation.hpp>
 #include <migraphx/memory_coloring.hpp>
 #include <migraphx/propagate_constant.hpp>
 #include <migraphx/register_target.hpp>
@@ -46,6 +48,7 @@
 #include <migraphx/simplify_reshapes.hpp>
 #include <migraphx/preallocate_param.hpp>
 #include <migraphx/cpu/fuse_ops.hpp>
+#include <migraphx/cpu/prepack_weights.hpp>
 #include <migraphx/cpu/write_literals.hpp>
 #include <migraphx/cpu/allocation_model.hpp>
 #include <migraphx/cpu/target.hpp>
@@ -62,9 +65,11 @@ namespace cpu {
 std::string target::name() const { return "cpu"; }
 
 // cppcheck-suppress constParameterReference
-std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_options&) const
+std::vector<pass> target::get_passes(migraphx::context& gctx,
+                                     const compile_options& options) const
 {
-    auto& ctx = any_cast<context>(gctx);
+    auto& ctx           = any_cast<context>(gctx);
+    ctx.exhaustive_tune = options.exhaustive_tune;
     std::set<shape::type_t> unsupported_types(shape::types().begin(), shape::types().end());
     unsupported_types.erase(shape::type_t::float_type);
     return {normalize_ops{},
@@ -77,7 +82,7 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             eliminate_identity{},
             eliminate_pad{},
             dead_code_elimination{},
-            rewrite_rnn{},
+            rewrite_rnn{true},
             dead_code_elimination{},
             eliminate_common_subexpression{},
             dead_code_elimination{},
@@ -95,6 +100,8 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{},
             propagate_constant{},
             dead_code_elimination{},
+            fuse_attention{},
+            dead_code_elimination{},
             lowering{},
             eliminate_contiguous{"dnnl::reorder"},
             dead_code_elimination{},
@@ -104,6 +111,11 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{},
             fuse_ops{&ctx},
             dead_code_elimination{},
+            inplace_allocation{
+                "cpu::allocate",
+                {"dnnl::binary", "dnnl::eltwise", "cpu::erf", "cpu::fmod", "cpu::mod"}},
+            dead_code_elimination{},
+            prepack_weights{},
             write_literals{},
             dead_code_elimination{},
             memory_coloring{"cpu::allocate"},
@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/tuning_db.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/sqlite.hpp>
+#include <migraphx/stringutils.hpp>
+#include <fstream>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_TUNING_DB);
+
+static std::string quote(const std::string& s) { return "'" + replace_string(s, "'", "''") + "'"; }
+
+tuning_db::tuning_db(fs::path p, std::string cpu_model)
+    : path(std::move(p)), cpu(std::move(cpu_model))
+{
+}
+
+std::string tuning_db::get_cpu_model()
+{
+    std::ifstream is("/proc/cpuinfo");
+    std::string line;
+    while(std::getline(is, line))
+    {
+        if(not starts_with(line, "model name"))
+            continue;
+        auto pos = line.find(':');
+        if(pos != std::string::npos)
+            return trim(line.substr(pos + 1));
+    }
+    return "unknown";
+}
+
+optional<value> tuning_db::get(const std::string& name, const value& problem) const
+{
+    auto key = name + to_json_string(problem);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(key);
+    if(it != cache.end())
+        return it->second;
+    optional<value> result = nullopt;
+    if(fs::exists(path))
+    {
+        auto db   = sqlite::read(path);
+        auto rows = db.execute("SELECT solution FROM tuning WHERE cpu = " + quote(cpu) +
+                               " AND name = " + quote(name) +
+                               " AND problem = " + quote(to_json_string(problem)) + ";");
+        if(not rows.empty())
+            result = from_json_string(rows.front().at("solution"));
+    }
+    cache[key] = result;
+    return result;
+}
+
+void tuning_db::insert(const std::string& name, const value& problem, const value& solution)
+{
+    assert(not solution.is_null());
+    std::lock_guard<std::mutex> lock(mutex);
+    if(path.has_parent_path())
+        fs::create_directories(path.parent_path());
+    auto db = sqlite::write(path);
+    db.execute("CREATE TABLE IF NOT EXISTS tuning (cpu TEXT, name TEXT, problem TEXT, "
+               "solution TEXT, PRIMARY KEY (cpu, name, problem));");
+    db.execute("INSERT OR REPLACE INTO tuning VALUES (" + quote(cpu) + ", " + quote(name) + ", " +
+               quote(to_json_string(problem)) + ", " + quote(to_json_string(solution)) + ");");
+    cache[name + to_json_string(problem)] = solution;
+}
+
+tuning_db& get_tuning_db()
+{
+    static tuning_db db{[] {
+        auto p = string_value_of(MIGRAPHX_CPU_TUNING_DB{});
+        if(not p.empty())
+            return fs::path{p};
+        return fs::temp_directory_path() / "migraphx" / "cpu_tuning.db";
+    }()};
+    return db;
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -47,6 +47,7 @@
 #include <migraphx/rewrite_low_precision.hpp>
 #include <migraphx/rewrite_pooling.hpp>
 #include <migraphx/rewrite_reduce.hpp>
+#include <migraphx/rewrite_resize.hpp>
 #include <migraphx/rewrite_quantization.hpp>
 #include <migraphx/rewrite_rnn.hpp>
 #include <migraphx/schedule.hpp>
@@ -122,7 +123,7 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
     // clang-format off
     return
     {
-        split_single_dyn_dim{},
+        split_single_dyn_dim{options.bucket_dynamic_shapes, options.bucket_pad_value},
         dead_code_elimination{},
         simplify_dyn_ops{},
         dead_code_elimination{},
@@ -144,6 +145,7 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
         dead_code_elimination{},
         inline_module{},
         rewrite_pooling{},
+        rewrite_resize{},
         dead_code_elimination{},
         rewrite_gelu{options.fast_math},
         optimize_module{},
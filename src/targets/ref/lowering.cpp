@@ -39,8 +39,11 @@
 #include <migraphx/op/softmax.hpp>
 #include <migraphx/op/argmax.hpp>
 #include <migraphx/op/argmin.hpp>
+#include <migraphx/op/attention.hpp>
 #include <migraphx/op/rnn_var_sl_last_output.hpp>
 #include <migraphx/shape_for_each.hpp>
+#include <migraphx/softmax.hpp>
+#include <migraphx/attention.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/par_dfor.hpp>
 #include <migraphx/clamp.hpp>
@@ -211,6 +214,10 @@ struct ref_op
     {
         return op.compute(output_shape, args);
     }
+    value attributes() const
+    {
+        return {{"side_effects", op.attributes().get("side_effects", false)}};
+    }
     value to_value() const
     {
         value v;
@@ -338,51 +345,49 @@ struct ref_softmax : auto_register_op<ref_softmax<Op>>
     argument compute(context&, const dyn_output& dyn_out, std::vector<argument> args) const
     {
         argument result{dyn_out.computed_shape};
-        auto batch_lens        = dyn_out.computed_shape.lens();
-        int64_t tuned_axis     = tune_axis(args[0].get_shape().lens().size(), op.axis, op.name());
-        std::size_t n_dims     = batch_lens[tuned_axis];
-        batch_lens[tuned_axis] = 1;
-        shape batch_shape{shape::int32_type, batch_lens};
-
+        auto tuned_axis = tune_axis(args[0].get_shape().lens().size(), op.axis, op.name());
         visit_all(result, args[0])([&](auto output, auto input) {
-            using value_type = accumulator_type<typename decltype(input)::value_type>;
-            std::vector<value_type> batch_max(batch_shape.elements(),
-                                              std::numeric_limits<value_type>::lowest());
-            std::vector<value_type> batch_sum(batch_shape.elements(), value_type(0));
-            par_for(batch_shape.elements(), [&](auto i) {
-                auto idx = batch_shape.multi(i);
-                for(std::size_t j = 0; j < n_dims; ++j)
-                {
-                    idx[tuned_axis] = j;
-                    batch_max[i] =
-                        std::max<value_type>(batch_max[i], input(idx.begin(), idx.end()));
-                }
+            migraphx::softmax(output, input, tuned_axis, op.output());
+        });
+        return result;
+    }
+};
 
-                for(std::size_t j = 0; j < n_dims; ++j)
-                {
-                    idx[tuned_axis]   = j;
-                    std::size_t index = dyn_out.computed_shape.index(idx);
-                    output[index]     = std::exp(input[index] - batch_max[i]);
-                }
+struct ref_attention
+{
+    op::attention op;
 
-                for(std::size_t j = 0; j < n_dims; ++j)
-                {
-                    idx[tuned_axis] = j;
-                    batch_sum[i] += output(idx.begin(), idx.end());
-                }
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
 
-                for(std::size_t j = 0; j < n_dims; ++j)
-                {
-                    idx[tuned_axis] = j;
-                    output(idx.begin(), idx.end()) =
-                        op.output()(output(idx.begin(), idx.end()), batch_sum[i]);
-                }
+    std::string name() const { return "ref::attention"; }
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        return op.compute_shape(inputs);
+    }
+    argument compute(context&, const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        if(args.size() == 4)
+        {
+            visit_all(result, args[0], args[1], args[2], args[3])(
+                [&](auto output, auto q, auto kt, auto mask, auto v) {
+                    migraphx::attention(output, q, kt, v, mask, op.scale, op.causal);
+                });
+        }
+        else
+        {
+            visit_all(result, args[0], args[1], args[2])([&](auto output, auto q, auto kt, auto v) {
+                migraphx::attention(output, q, kt, v, decltype(q){}, op.scale, op.causal);
             });
-        });
-
+        }
         return result;
     }
 };
+MIGRAPHX_REGISTER_OP(ref_attention)
 
 struct ref_rnn_var_sl_last_output
 {
@@ -450,6 +455,7 @@ struct ref_apply
 
     void init()
     {
+        apply_map["attention"]  = extend_op<ref_attention, op::attention>();
         apply_map["dot"]        = extend_op<ref_gemm, op::dot>();
         apply_map["quant_dot"]  = extend_op<ref_quant_gemm, op::quant_dot>();
         apply_map["im2col"]     = extend_op<ref_im2col, op::im2col>();
@@ -49,7 +49,7 @@ std::vector<pass> target::get_passes(migraphx::context&, const compile_options&)
             dead_code_elimination{},
             insert_pad{},
             dead_code_elimination{},
-            rewrite_rnn{},
+            rewrite_rnn{true},
             dead_code_elimination{},
             auto_contiguous{},
             dead_code_elimination{},
@@ -0,0 +1,161 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/buffer_pool.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <algorithm>
+#include <limits>
+#include <test.hpp>
+
+TEST_CASE(reuse_size_class)
+{
+    migraphx::buffer_pool pool;
+    auto* p = pool.allocate(100).get();
+    CHECK(pool.get_statistics().misses == 1);
+    CHECK(pool.get_statistics().bytes_held == 112);
+    auto b = pool.allocate(110);
+    CHECK(b.get() == p);
+    CHECK(pool.get_statistics().hits == 1);
+    CHECK(pool.get_statistics().bytes_held == 0);
+    auto c = pool.allocate(120);
+    CHECK(c.get() != p);
+    CHECK(pool.get_statistics().misses == 2);
+}
+
+TEST_CASE(size_classes)
+{
+    migraphx::buffer_pool pool;
+    // Allocations are rounded up by at most a quarter
+    for(std::size_t n : {65, 1000, 4097, 5000, 1000000})
+    {
+        {
+            auto b = pool.allocate(n);
+        }
+        auto held = pool.get_statistics().bytes_held;
+        CHECK(held >= n);
+        CHECK(held - n <= n / 4);
+        pool.trim();
+    }
+}
+
+TEST_CASE(size_class_overflow)
+{
+    migraphx::buffer_pool pool;
+    EXPECT(test::throws([&] { pool.allocate(std::numeric_limits<std::size_t>::max()); }));
+}
+
+TEST_CASE(reuse_zeroed)
+{
+    migraphx::buffer_pool pool;
+    {
+        auto b = pool.allocate(64);
+        std::fill(b.get(), b.get() + 64, 1);
+    }
+    auto b = pool.allocate(64);
+    CHECK(std::all_of(b.get(), b.get() + 64, [](char x) { return x == 0; }));
+}
+
+TEST_CASE(trim)
+{
+    migraphx::buffer_pool pool;
+    {
+        auto b1 = pool.allocate(64);
+        auto b2 = pool.allocate(64);
+        auto b3 = pool.allocate(1024);
+    }
+    CHECK(pool.get_statistics().bytes_held == 1152);
+    pool.trim(1024);
+    CHECK(pool.get_statistics().bytes_held <= 1024);
+    pool.trim();
+    CHECK(pool.get_statistics().bytes_held == 0);
+}
+
+TEST_CASE(max_bytes)
+{
+    migraphx::buffer_pool pool{128};
+    {
+        auto b1 = pool.allocate(128);
+        auto b2 = pool.allocate(128);
+    }
+    CHECK(pool.get_statistics().bytes_held == 128);
+}
+
+TEST_CASE(outlive_pool)
+{
+    std::shared_ptr<char> b;
+    {
+        migraphx::buffer_pool pool;
+        b = pool.allocate(64);
+    }
+    b.get()[0] = 1;
+    CHECK(b.get()[0] == 1);
+}
+
+TEST_CASE(argument_scope)
+{
+    migraphx::buffer_pool pool;
+    migraphx::shape s{migraphx::shape::float_type, {4}};
+    CHECK(migraphx::get_current_buffer_pool() == nullptr);
+    {
+        migraphx::buffer_pool_scope scope{&pool};
+        CHECK(migraphx::get_current_buffer_pool() == &pool);
+        {
+            migraphx::argument a{s};
+        }
+        migraphx::argument a{s};
+        CHECK(a.get_shape() == s);
+    }
+    CHECK(migraphx::get_current_buffer_pool() == nullptr);
+    CHECK(pool.get_statistics().hits == 1);
+    CHECK(pool.get_statistics().misses == 1);
+}
+
+TEST_CASE(program_eval)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {8}};
+    auto x = mm->add_parameter("x", s);
+    auto y = mm->add_instruction(migraphx::make_op("relu"), x);
+    mm->add_instruction(migraphx::make_op("neg"), y);
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> data(8, 1);
+    migraphx::parameter_map params;
+    params["x"] = migraphx::argument{s, data.data()};
+    p.eval(params);
+    auto misses = p.get_buffer_pool().get_statistics().misses;
+    CHECK(misses > 0);
+    auto result = p.eval(params).back();
+    CHECK(p.get_buffer_pool().get_statistics().misses == misses);
+    CHECK(p.get_buffer_pool().get_statistics().hits > 0);
+    std::vector<float> gold(8, -1);
+    std::vector<float> results;
+    result.visit([&](auto output) { results.assign(output.begin(), output.end()); });
+    CHECK(results == gold);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
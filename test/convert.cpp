@@ -0,0 +1,124 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/convert.hpp>
+#include <migraphx/bit_cast.hpp>
+#include <migraphx/float8.hpp>
+#include <migraphx/half.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "test.hpp"
+
+template <class T>
+static bool same_bits(const T& x, const T& y)
+{
+    return std::memcmp(&x, &y, sizeof(T)) == 0;
+}
+
+// Compare convert_n against converting each element with convert_value
+template <class U, class T>
+static bool check_convert_n(const std::vector<T>& input)
+{
+    std::vector<U> result(input.size());
+    migraphx::convert_n(input.data(), result.data(), input.size());
+    for(std::size_t i = 0; i < input.size(); i++)
+    {
+        U gold = migraphx::convert_value<U>(input[i]);
+        if(not same_bits(result[i], gold))
+            return false;
+    }
+    return true;
+}
+
+// Every bit pattern of T
+template <class T>
+static std::vector<T> all_values()
+{
+    using index = migraphx::float_table_index<T>;
+    std::vector<T> result;
+    for(std::size_t i = 0; i < (std::size_t{1} << (8 * sizeof(T))); i++)
+        result.push_back(migraphx::bit_cast<T>(static_cast<index>(i)));
+    return result;
+}
+
+// Floats with every upper 16 bits, combined with lower bits around the rounding ties
+static std::vector<float> float_values()
+{
+    std::vector<float> result;
+    for(std::uint32_t i = 0; i < (1u << 16u); i++)
+    {
+        for(std::uint32_t low : {0x0u, 0x1u, 0x7fffu, 0x8000u, 0x8001u, 0xffffu})
+            result.push_back(migraphx::bit_cast<float>((i << 16u) | low));
+    }
+    return result;
+}
+
+template <class T>
+static void check_fp8()
+{
+    auto values = all_values<T>();
+    EXPECT(check_convert_n<float>(values));
+    EXPECT(check_convert_n<double>(values));
+    EXPECT(check_convert_n<migraphx::half>(values));
+    EXPECT(check_convert_n<int32_t>(values));
+    EXPECT(check_convert_n<T>(float_values()));
+    EXPECT(check_convert_n<T>(all_values<migraphx::half>()));
+}
+
+TEST_CASE(convert_fp8e4m3fnuz) { check_fp8<migraphx::fp8::fp8e4m3fnuz>(); }
+
+TEST_CASE(convert_fp8e4m3fn) { check_fp8<migraphx::fp8::fp8e4m3fn>(); }
+
+TEST_CASE(convert_fp8e5m2) { check_fp8<migraphx::fp8::fp8e5m2>(); }
+
+TEST_CASE(convert_fp8e5m2fnuz) { check_fp8<migraphx::fp8::fp8e5m2fnuz>(); }
+
+TEST_CASE(convert_half)
+{
+    auto values = all_values<migraphx::half>();
+    EXPECT(check_convert_n<float>(values));
+    EXPECT(check_convert_n<int8_t>(values));
+    EXPECT(check_convert_n<migraphx::half>(float_values()));
+}
+
+TEST_CASE(convert_float)
+{
+    auto values = float_values();
+    EXPECT(check_convert_n<double>(values));
+    EXPECT(check_convert_n<int64_t>(values));
+    EXPECT(check_convert_n<uint8_t>(values));
+    EXPECT(check_convert_n<int8_t>(values));
+}
+
+TEST_CASE(convert_to_double)
+{
+    for(auto x : all_values<migraphx::fp8::fp8e4m3fnuz>())
+    {
+        auto gold = static_cast<double>(x);
+        auto y    = migraphx::to_double(x);
+        EXPECT(same_bits(y, gold));
+    }
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
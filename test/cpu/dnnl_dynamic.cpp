@@ -0,0 +1,93 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <algorithm>
+#include <test.hpp>
+
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape xs{migraphx::shape::float_type, {{1, 4}, {3, 3}, {8, 8}, {8, 8}}};
+    migraphx::shape ws{migraphx::shape::float_type, {4, 3, 3, 3}};
+    migraphx::shape ys{migraphx::shape::float_type, {{1, 4}, {32, 32}}};
+    migraphx::shape bs{migraphx::shape::float_type, {32, 16}};
+    auto x    = mm->add_parameter("x", xs);
+    auto w    = mm->add_literal(migraphx::generate_literal(ws, 1));
+    auto conv = mm->add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), x, w);
+    auto relu = mm->add_instruction(migraphx::make_op("relu"), conv);
+    auto sm   = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), relu);
+    auto y    = mm->add_parameter("y", ys);
+    auto b    = mm->add_literal(migraphx::generate_literal(bs, 2));
+    auto dot  = mm->add_instruction(migraphx::make_op("dot"), y, b);
+    mm->add_return({sm, dot});
+    return p;
+}
+
+TEST_CASE(dnnl_dynamic_batch)
+{
+    auto p   = create_program();
+    auto cpu = p;
+    auto ref = p;
+    cpu.compile(migraphx::make_target("cpu"));
+    ref.compile(migraphx::make_target("ref"));
+
+    // The dnnl ops stay dynamic instead of falling back to the reference kernels
+    auto* mm = cpu.get_main_module();
+    for(const std::string name : {"dnnl::convolution", "dnnl::softmax", "dnnl::dot"})
+    {
+        EXPECT(std::any_of(mm->begin(), mm->end(), [&](const auto& ins) {
+            return ins.name() == name and ins.get_shape().dynamic();
+        }));
+    }
+
+    // Shrink and grow the batch, so allocations sized for another batch are reused
+    for(std::size_t batch : {4, 1, 3, 4, 2})
+    {
+        migraphx::shape xs{migraphx::shape::float_type, {batch, 3, 8, 8}};
+        migraphx::shape ys{migraphx::shape::float_type, {batch, 32}};
+        migraphx::parameter_map params;
+        params["x"]  = migraphx::generate_argument(xs, batch);
+        params["y"]  = migraphx::generate_argument(ys, batch + 1);
+        auto results = cpu.eval(params);
+        auto golds   = ref.eval(params);
+        EXPECT(results.size() == golds.size());
+        for(std::size_t i = 0; i < results.size(); i++)
+        {
+            EXPECT(results[i].get_shape().lens() == golds[i].get_shape().lens());
+            std::vector<float> result;
+            std::vector<float> gold;
+            results[i].visit([&](auto output) { result.assign(output.begin(), output.end()); });
+            golds[i].visit([&](auto output) { gold.assign(output.begin(), output.end()); });
+            EXPECT(migraphx::verify::verify_rms_range(result, gold));
+        }
+    }
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,110 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/dnnl.hpp>
+#include <string>
+#include <test.hpp>
+
+// An entry that is told apart from others by the size of its memory descriptor
+static migraphx::cpu::dnnl_primitive_cache::entry make_entry(int n)
+{
+    migraphx::cpu::dnnl_primitive_cache::entry e;
+    e.md[0] = dnnl::memory::desc{{n}, dnnl::memory::data_type::f32, dnnl::memory::format_tag::a};
+    return e;
+}
+
+static int entry_size(const migraphx::cpu::dnnl_primitive_cache::entry& e)
+{
+    return static_cast<int>(e.md.at(0).dims().front());
+}
+
+struct counted_get
+{
+    migraphx::cpu::dnnl_primitive_cache* cache;
+    int created = 0;
+
+    int operator()(const std::string& key, int n)
+    {
+        return entry_size(cache->get(key, [&] {
+            created++;
+            return make_entry(n);
+        }));
+    }
+};
+
+TEST_CASE(cache_shares_entries)
+{
+    migraphx::cpu::dnnl_primitive_cache cache{4};
+    counted_get get{&cache};
+    EXPECT(get("a", 1) == 1);
+    EXPECT(get("a", 2) == 1);
+    EXPECT(get("b", 2) == 2);
+    EXPECT(get("a", 3) == 1);
+    EXPECT(get.created == 2);
+    EXPECT(cache.size() == 2);
+}
+
+TEST_CASE(cache_capacity)
+{
+    migraphx::cpu::dnnl_primitive_cache cache{2};
+    counted_get get{&cache};
+    get("a", 1);
+    get("b", 2);
+    get("c", 3);
+    EXPECT(cache.size() == 2);
+    EXPECT(get.created == 3);
+    // a was evicted, so it is created again
+    EXPECT(get("a", 4) == 4);
+    EXPECT(get.created == 4);
+    EXPECT(cache.size() == 2);
+}
+
+TEST_CASE(cache_evicts_least_recently_used)
+{
+    migraphx::cpu::dnnl_primitive_cache cache{2};
+    counted_get get{&cache};
+    get("a", 1);
+    get("b", 2);
+    // Using a makes b the least recently used
+    get("a", 1);
+    get("c", 3);
+    EXPECT(get.created == 3);
+    EXPECT(get("a", 5) == 1);
+    EXPECT(get.created == 3);
+    EXPECT(get("b", 6) == 6);
+    EXPECT(get.created == 4);
+}
+
+TEST_CASE(cache_erase)
+{
+    migraphx::cpu::dnnl_primitive_cache cache{2};
+    counted_get get{&cache};
+    get("a", 1);
+    cache.erase("a");
+    cache.erase("b");
+    EXPECT(cache.size() == 0);
+    EXPECT(get("a", 2) == 2);
+    EXPECT(get.created == 2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
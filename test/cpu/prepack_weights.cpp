@@ -0,0 +1,95 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+#include <algorithm>
+#include <test.hpp>
+
+static migraphx::program create_conv_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape xs{migraphx::shape::float_type, {2, 32, 14, 14}};
+    migraphx::shape ws{migraphx::shape::float_type, {64, 32, 3, 3}};
+    auto x    = mm->add_parameter("x", xs);
+    auto w    = mm->add_literal(migraphx::generate_literal(ws, 1));
+    auto conv = mm->add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), x, w);
+    mm->add_return({conv});
+    return p;
+}
+
+static migraphx::program create_dot_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape as{migraphx::shape::float_type, {16, 256}};
+    migraphx::shape bs{migraphx::shape::float_type, {256, 128}};
+    auto a   = mm->add_parameter("a", as);
+    auto b   = mm->add_literal(migraphx::generate_literal(bs, 1));
+    auto dot = mm->add_instruction(migraphx::make_op("dot"), a, b);
+    mm->add_return({dot});
+    return p;
+}
+
+static bool is_prepacked(const migraphx::program& p, const std::string& name)
+{
+    auto* mm = p.get_main_module();
+    return std::any_of(mm->begin(), mm->end(), [&](const auto& ins) {
+        return ins.name() == name and not ins.get_operator().to_value().at("prepack").empty();
+    });
+}
+
+static void verify_prepacked(const migraphx::program& p, const std::string& name)
+{
+    auto cpu = p;
+    auto ref = p;
+    cpu.compile(migraphx::make_target("cpu"));
+    ref.compile(migraphx::make_target("ref"));
+    EXPECT(is_prepacked(cpu, name));
+
+    migraphx::parameter_map params;
+    for(auto&& [pname, s] : p.get_parameter_shapes())
+        params[pname] = migraphx::generate_argument(s, 2);
+    // Run twice, so the packed weights are reused by the second call
+    for(int i = 0; i < 2; i++)
+    {
+        auto result = cpu.eval(params).back();
+        auto gold   = ref.eval(params).back();
+        std::vector<float> result_data;
+        std::vector<float> gold_data;
+        result.visit([&](auto output) { result_data.assign(output.begin(), output.end()); });
+        gold.visit([&](auto output) { gold_data.assign(output.begin(), output.end()); });
+        EXPECT(migraphx::verify::verify_rms_range(result_data, gold_data));
+    }
+}
+
+TEST_CASE(prepack_convolution) { verify_prepacked(create_conv_program(), "dnnl::convolution"); }
+
+TEST_CASE(prepack_dot) { verify_prepacked(create_dot_program(), "dnnl::dot"); }
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
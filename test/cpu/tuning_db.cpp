@@ -0,0 +1,102 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/cpu/tuning_db.hpp>
+#include <migraphx/json.hpp>
+#include <migraphx/tmp_dir.hpp>
+#include <test.hpp>
+
+// The solution in the db as json, since numbers read back from json can change their type, or
+// an empty string when there is none
+static std::string
+lookup(const migraphx::cpu::tuning_db& db, const std::string& name, const migraphx::value& problem)
+{
+    auto result = db.get(name, problem);
+    if(result.has_value())
+        return migraphx::to_json_string(*result);
+    return "";
+}
+
+TEST_CASE(tuning_db_missing)
+{
+    migraphx::tmp_dir td{};
+    migraphx::cpu::tuning_db db{td.path / "tuning.db", "cpu0"};
+    EXPECT(lookup(db, "dnnl::dot", "problem").empty());
+}
+
+TEST_CASE(tuning_db_round_trip)
+{
+    migraphx::tmp_dir td{};
+    auto path                = td.path / "tuning.db";
+    migraphx::value problem  = {{"lens", {2, 3}}, {"type", "float"}};
+    migraphx::value solution = {{"impl", 2}, {"name", "jit:avx2"}};
+    {
+        migraphx::cpu::tuning_db db{path, "cpu0"};
+        db.insert("dnnl::dot", problem, solution);
+        EXPECT(lookup(db, "dnnl::dot", problem) == migraphx::to_json_string(solution));
+    }
+    // A new db reads the solution back from the file
+    migraphx::cpu::tuning_db db{path, "cpu0"};
+    EXPECT(lookup(db, "dnnl::dot", problem) == migraphx::to_json_string(solution));
+    EXPECT(lookup(db, "dnnl::convolution", problem).empty());
+    EXPECT(lookup(db, "dnnl::dot", migraphx::value{{"lens", {3, 2}}}).empty());
+
+    // Inserting again replaces the solution
+    migraphx::value solution2 = {{"impl", 0}, {"name", "ref"}};
+    db.insert("dnnl::dot", problem, solution2);
+    EXPECT(lookup(migraphx::cpu::tuning_db{path, "cpu0"}, "dnnl::dot", problem) ==
+           migraphx::to_json_string(solution2));
+}
+
+TEST_CASE(tuning_db_cpu_model)
+{
+    migraphx::tmp_dir td{};
+    auto path = td.path / "tuning.db";
+    migraphx::cpu::tuning_db db0{path, "cpu0"};
+    migraphx::cpu::tuning_db db1{path, "cpu1"};
+    db0.insert("dnnl::dot", "problem", {{"impl", 1}});
+    db1.insert("dnnl::dot", "problem", {{"impl", 2}});
+    EXPECT(lookup(migraphx::cpu::tuning_db{path, "cpu0"}, "dnnl::dot", "problem") ==
+           migraphx::to_json_string({{"impl", 1}}));
+    EXPECT(lookup(migraphx::cpu::tuning_db{path, "cpu1"}, "dnnl::dot", "problem") ==
+           migraphx::to_json_string({{"impl", 2}}));
+    EXPECT(lookup(migraphx::cpu::tuning_db{path, "cpu2"}, "dnnl::dot", "problem").empty());
+}
+
+TEST_CASE(tuning_db_quoting)
+{
+    migraphx::tmp_dir td{};
+    auto path = td.path / "tuning.db";
+    // Quotes in the names, problems and solutions are stored as they are
+    std::string cpu          = "Vendor's \"cpu\"";
+    std::string name         = "op'); DROP TABLE tuning; --";
+    migraphx::value problem  = {{"key", "it's"}};
+    migraphx::value solution = {{"name", "'quoted'"}};
+    migraphx::cpu::tuning_db{path, cpu}.insert(name, problem, solution);
+    migraphx::cpu::tuning_db{path, cpu}.insert("other", problem, solution);
+    migraphx::cpu::tuning_db db{path, cpu};
+    EXPECT(lookup(db, name, problem) == migraphx::to_json_string(solution));
+    EXPECT(lookup(db, "other", problem) == migraphx::to_json_string(solution));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
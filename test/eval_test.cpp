@@ -499,6 +499,75 @@ TEST_CASE(eval_context3)
     EXPECT(not is_shared(t.ctx, p.get_context()));
 }
 
+TEST_CASE(eval_state)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::int32_type, {1, 4}};
+    auto state = mm->add_state("x", s);
+    auto one   = mm->add_literal(migraphx::literal{{migraphx::shape::int32_type, {1, 1}}, {1}});
+    auto index = mm->add_parameter("index", {migraphx::shape::int32_type, {1}});
+    mm->add_instruction(migraphx::make_op("tensor_scatter", {{"axis", 1}}), state, one, index);
+    p.compile(id_target{});
+    for(int i : {2, 0})
+        p.eval({{"index", migraphx::argument{{migraphx::shape::int32_type, {1}}, &i}}});
+    std::vector<int> result;
+    p.get_state("x").visit([&](auto x) { result.assign(x.begin(), x.end()); });
+    EXPECT(result == std::vector<int>{1, 0, 1, 0});
+    EXPECT(test::throws([&] { p.get_state("y"); }));
+}
+
+TEST_CASE(eval_state_order)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::int32_type, {1, 4}};
+    auto zeros  = mm->add_literal(migraphx::literal{s, {0, 0, 0, 0}});
+    auto one    = mm->add_literal(migraphx::literal{{migraphx::shape::int32_type, {1, 1}}, {1}});
+    auto index  = mm->add_parameter("index", {migraphx::shape::int32_type, {1}});
+    auto x1     = mm->add_state("x", s);
+    auto before = mm->add_instruction(migraphx::make_op("add"), x1, zeros);
+    auto x2     = mm->add_state("x", s);
+    mm->add_instruction(migraphx::make_op("tensor_scatter", {{"axis", 1}}), x2, one, index);
+    auto x3    = mm->add_state("x", s);
+    auto after = mm->add_instruction(migraphx::make_op("add"), x3, zeros);
+    mm->add_return({before, after});
+    p.compile(id_target{});
+    auto run = [&](int i) {
+        migraphx::shape is{migraphx::shape::int32_type, {1}};
+        auto results = p.eval({{"index", migraphx::argument{is, &i}}});
+        std::vector<std::vector<int>> values;
+        for(const auto& r : results)
+            r.visit([&](auto x) { values.emplace_back(x.begin(), x.end()); });
+        return values;
+    };
+    EXPECT(run(2) == std::vector<std::vector<int>>{{0, 0, 0, 0}, {0, 0, 1, 0}});
+    EXPECT(run(0) == std::vector<std::vector<int>>{{0, 0, 1, 0}, {1, 0, 1, 0}});
+}
+
+TEST_CASE(eval_state_shape_mismatch)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x1  = mm->add_state("x", {migraphx::shape::float_type, {2}});
+    auto x2  = mm->add_state("x", {migraphx::shape::float_type, {3}});
+    mm->add_return({x1, x2});
+    EXPECT(test::throws([&] { p.eval({}); }));
+}
+
+TEST_CASE(state_serialize)
+{
+    migraphx::program p1;
+    auto* mm = p1.get_main_module();
+    auto x   = mm->add_state("x", {migraphx::shape::float_type, {2}});
+    auto y   = mm->add_parameter("y", {migraphx::shape::float_type, {2}});
+    mm->add_instruction(migraphx::make_op("add"), x, y);
+    migraphx::program p2;
+    p2.from_value(p1.to_value());
+    EXPECT(p1 == p2);
+    EXPECT(p2.get_state("x").get_shape() == migraphx::shape{migraphx::shape::float_type, {2}});
+}
+
 struct cout_redirect
 {
     cout_redirect()                     = delete;
@@ -0,0 +1,202 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/fuse_attention.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+
+#include <test.hpp>
+#include <limits>
+
+void run_pass(migraphx::program& p)
+{
+    migraphx::run_passes(p, {migraphx::fuse_attention{}, migraphx::dead_code_elimination{}});
+}
+
+static migraphx::instruction_ref
+add_scalar(migraphx::module& m, float x, migraphx::instruction_ref ins)
+{
+    auto l = m.add_literal(migraphx::literal{{migraphx::shape::float_type}, {x}});
+    return m.add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", ins->get_shape().lens()}}), l);
+}
+
+static std::vector<float> causal_mask(std::size_t m, std::size_t n, float masked)
+{
+    std::vector<float> result(m * n);
+    for(std::size_t i = 0; i < m; i++)
+    {
+        for(std::size_t j = 0; j < n; j++)
+            result[i * n + j] = j + m > i + n ? masked : 0.0f;
+    }
+    return result;
+}
+
+TEST_CASE(attention_scale_mask)
+{
+    migraphx::shape qs{migraphx::shape::float_type, {2, 4, 8, 16}};
+    migraphx::shape ks{migraphx::shape::float_type, {2, 4, 16, 8}};
+    migraphx::shape ms{migraphx::shape::float_type, {2, 4, 8, 8}};
+    migraphx::program p1;
+    {
+        auto* mm    = p1.get_main_module();
+        auto q      = mm->add_parameter("q", qs);
+        auto kt     = mm->add_parameter("kt", ks);
+        auto mask   = mm->add_parameter("mask", ms);
+        auto v      = mm->add_parameter("v", qs);
+        auto scores = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto scaled =
+            mm->add_instruction(migraphx::make_op("mul"), add_scalar(*mm, 0.25f, scores), scores);
+        auto masked = mm->add_instruction(migraphx::make_op("add"), scaled, mask);
+        auto sm = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 3}}), masked);
+        auto r  = mm->add_instruction(migraphx::make_op("dot"), sm, v);
+        mm->add_return({r});
+    }
+    run_pass(p1);
+    migraphx::program p2;
+    {
+        auto* mm  = p2.get_main_module();
+        auto q    = mm->add_parameter("q", qs);
+        auto kt   = mm->add_parameter("kt", ks);
+        auto mask = mm->add_parameter("mask", ms);
+        auto v    = mm->add_parameter("v", qs);
+        auto r    = mm->add_instruction(
+            migraphx::make_op("attention", {{"scale", 0.25f}, {"causal", false}}), q, kt, mask, v);
+        mm->add_return({r});
+    }
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(attention_div_scale)
+{
+    migraphx::shape qs{migraphx::shape::float_type, {3, 10, 4}};
+    migraphx::shape ks{migraphx::shape::float_type, {3, 4, 12}};
+    migraphx::shape vs{migraphx::shape::float_type, {3, 12, 6}};
+    migraphx::program p1;
+    {
+        auto* mm    = p1.get_main_module();
+        auto q      = mm->add_parameter("q", qs);
+        auto kt     = mm->add_parameter("kt", ks);
+        auto v      = mm->add_parameter("v", vs);
+        auto scores = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto scaled =
+            mm->add_instruction(migraphx::make_op("div"), scores, add_scalar(*mm, 2.0f, scores));
+        auto sm = mm->add_instruction(migraphx::make_op("softmax", {{"axis", -1}}), scaled);
+        auto r  = mm->add_instruction(migraphx::make_op("dot"), sm, v);
+        mm->add_return({r});
+    }
+    run_pass(p1);
+    migraphx::program p2;
+    {
+        auto* mm = p2.get_main_module();
+        auto q   = mm->add_parameter("q", qs);
+        auto kt  = mm->add_parameter("kt", ks);
+        auto v   = mm->add_parameter("v", vs);
+        auto r   = mm->add_instruction(
+            migraphx::make_op("attention", {{"scale", 0.5f}, {"causal", false}}), q, kt, v);
+        mm->add_return({r});
+    }
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(attention_causal_mask)
+{
+    migraphx::shape qs{migraphx::shape::float_type, {2, 6, 4}};
+    migraphx::shape ks{migraphx::shape::float_type, {2, 4, 9}};
+    migraphx::shape vs{migraphx::shape::float_type, {2, 9, 4}};
+    migraphx::shape ms{migraphx::shape::float_type, {6, 9}};
+    migraphx::program p1;
+    {
+        auto* mm    = p1.get_main_module();
+        auto q      = mm->add_parameter("q", qs);
+        auto kt     = mm->add_parameter("kt", ks);
+        auto v      = mm->add_parameter("v", vs);
+        auto scores = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto mask   = mm->add_literal(
+            migraphx::literal{ms, causal_mask(6, 9, std::numeric_limits<float>::lowest())});
+        auto bmask = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"out_lens", scores->get_shape().lens()}}), mask);
+        auto masked = mm->add_instruction(migraphx::make_op("add"), bmask, scores);
+        auto sm     = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 2}}), masked);
+        auto r      = mm->add_instruction(migraphx::make_op("dot"), sm, v);
+        mm->add_return({r});
+    }
+    run_pass(p1);
+    migraphx::program p2;
+    {
+        auto* mm = p2.get_main_module();
+        auto q   = mm->add_parameter("q", qs);
+        auto kt  = mm->add_parameter("kt", ks);
+        auto v   = mm->add_parameter("v", vs);
+        auto r   = mm->add_instruction(
+            migraphx::make_op("attention", {{"scale", 1.0f}, {"causal", true}}), q, kt, v);
+        mm->add_return({r});
+    }
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(attention_non_uniform_scale)
+{
+    migraphx::shape qs{migraphx::shape::float_type, {2, 3}};
+    migraphx::shape ss{migraphx::shape::float_type, {2, 2}};
+    migraphx::program p1;
+    {
+        auto* mm    = p1.get_main_module();
+        auto q      = mm->add_parameter("q", qs);
+        auto kt     = mm->add_parameter("kt", migraphx::shape{migraphx::shape::float_type, {3, 2}});
+        auto v      = mm->add_parameter("v", ss);
+        auto scores = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto scale  = mm->add_literal(migraphx::literal{ss, {1.0f, 2.0f, 3.0f, 4.0f}});
+        auto scaled = mm->add_instruction(migraphx::make_op("mul"), scores, scale);
+        auto sm     = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), scaled);
+        auto r      = mm->add_instruction(migraphx::make_op("dot"), sm, v);
+        mm->add_return({r});
+    }
+    auto p2 = p1;
+    run_pass(p1);
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(attention_softmax_not_last_axis)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 4, 4}};
+    migraphx::program p1;
+    {
+        auto* mm    = p1.get_main_module();
+        auto q      = mm->add_parameter("q", s);
+        auto kt     = mm->add_parameter("kt", s);
+        auto v      = mm->add_parameter("v", s);
+        auto scores = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto sm     = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), scores);
+        auto r      = mm->add_instruction(migraphx::make_op("dot"), sm, v);
+        mm->add_return({r});
+    }
+    auto p2 = p1;
+    run_pass(p1);
+    EXPECT(p1 == p2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,202 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/inplace_allocation.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/module.hpp>
+#include <basic_ops.hpp>
+#include <test.hpp>
+
+void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m,
+                         {migraphx::inplace_allocation{"allocate", {"unary", "binary"}},
+                          migraphx::dead_code_elimination{}});
+}
+
+struct allocate
+{
+    migraphx::shape s{};
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::pack(f(self.s, "shape"));
+    }
+
+    std::string name() const { return "allocate"; }
+    migraphx::shape compute_shape(const std::vector<migraphx::shape>& inputs) const
+    {
+        migraphx::check_shapes{inputs, *this}.has(0);
+        return s;
+    }
+    migraphx::argument compute(migraphx::context&,
+                               const migraphx::shape& output_shape,
+                               const std::vector<migraphx::argument>&) const
+    {
+        return migraphx::argument{output_shape};
+    }
+};
+
+// Elementwise operator that writes to its last input
+template <std::size_t N>
+struct elementwise_op
+{
+    std::string name() const { return N == 1 ? "unary" : "binary"; }
+    migraphx::shape compute_shape(const std::vector<migraphx::shape>& inputs) const
+    {
+        migraphx::check_shapes{inputs, *this}.has(N + 1);
+        return inputs.back();
+    }
+    migraphx::argument compute(migraphx::context&,
+                               const migraphx::shape&,
+                               const std::vector<migraphx::argument>& args) const
+    {
+        return args.back();
+    }
+    std::ptrdiff_t output_alias(const std::vector<migraphx::shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+using unary_op  = elementwise_op<1>;
+using binary_op = elementwise_op<2>;
+
+migraphx::instruction_ref add_alloc(migraphx::module& m, const migraphx::shape& s)
+{
+    return m.add_instruction(allocate{s});
+}
+
+bool is_inplace(migraphx::instruction_ref ins)
+{
+    return ins->inputs().front() == ins->inputs().back();
+}
+
+std::size_t count_allocs(const migraphx::module& m)
+{
+    return std::count_if(m.begin(), m.end(), [](auto&& ins) { return ins.name() == "allocate"; });
+}
+
+TEST_CASE(dead_input)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {4, 3}};
+    auto x  = m.add_parameter("x", s);
+    auto a1 = add_alloc(m, s);
+    auto u1 = m.add_instruction(unary_op{}, x, a1);
+    auto a2 = add_alloc(m, s);
+    auto u2 = m.add_instruction(unary_op{}, u1, a2);
+    auto a3 = add_alloc(m, s);
+    auto u3 = m.add_instruction(unary_op{}, u2, a3);
+    m.add_return({u3});
+    run_pass(m);
+    CHECK(not is_inplace(u1));
+    CHECK(is_inplace(u2));
+    CHECK(is_inplace(u3));
+    CHECK(count_allocs(m) == 1);
+    CHECK(bool{migraphx::instruction::get_output_alias(u3) == a1});
+}
+
+TEST_CASE(live_input)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {4, 3}};
+    auto x  = m.add_parameter("x", s);
+    auto a1 = add_alloc(m, s);
+    auto u1 = m.add_instruction(unary_op{}, x, a1);
+    auto a2 = add_alloc(m, s);
+    auto u2 = m.add_instruction(unary_op{}, u1, a2);
+    auto a3 = add_alloc(m, s);
+    auto b1 = m.add_instruction(binary_op{}, u2, u1, a3);
+    m.add_return({b1});
+    run_pass(m);
+    CHECK(not is_inplace(u2));
+    CHECK(is_inplace(b1));
+    CHECK(count_allocs(m) == 2);
+}
+
+TEST_CASE(same_buffer_inputs)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {4, 3}};
+    auto x  = m.add_parameter("x", s);
+    auto a1 = add_alloc(m, s);
+    auto u1 = m.add_instruction(unary_op{}, x, a1);
+    auto a2 = add_alloc(m, s);
+    auto b1 = m.add_instruction(binary_op{}, u1, u1, a2);
+    m.add_return({b1});
+    run_pass(m);
+    CHECK(not is_inplace(b1));
+    CHECK(count_allocs(m) == 2);
+}
+
+TEST_CASE(param_input)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {4, 3}};
+    auto x  = m.add_parameter("x", s);
+    auto a1 = add_alloc(m, s);
+    auto u1 = m.add_instruction(unary_op{}, x, a1);
+    m.add_return({u1});
+    run_pass(m);
+    CHECK(not is_inplace(u1));
+    CHECK(count_allocs(m) == 1);
+}
+
+TEST_CASE(different_shape)
+{
+    migraphx::module m;
+    migraphx::shape s1{migraphx::shape::float_type, {4, 3}};
+    migraphx::shape s2{migraphx::shape::int32_type, {4, 3}};
+    auto x  = m.add_parameter("x", s1);
+    auto a1 = add_alloc(m, s1);
+    auto u1 = m.add_instruction(unary_op{}, x, a1);
+    auto a2 = add_alloc(m, s2);
+    auto u2 = m.add_instruction(unary_op{}, u1, a2);
+    m.add_return({u2});
+    run_pass(m);
+    CHECK(not is_inplace(u2));
+    CHECK(count_allocs(m) == 2);
+}
+
+TEST_CASE(aliased_input)
+{
+    migraphx::module m;
+    migraphx::shape s{migraphx::shape::float_type, {4, 3}};
+    auto x  = m.add_parameter("x", s);
+    auto a1 = add_alloc(m, s);
+    auto u1 = m.add_instruction(unary_op{}, x, a1);
+    auto p1 = m.add_instruction(pass_op{}, u1);
+    auto a2 = add_alloc(m, s);
+    auto u2 = m.add_instruction(unary_op{}, u1, a2);
+    m.add_return({u2, p1});
+    run_pass(m);
+    CHECK(not is_inplace(u2));
+    CHECK(count_allocs(m) == 2);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
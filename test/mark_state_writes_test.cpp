@@ -0,0 +1,155 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/mark_state_writes.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/ranges.hpp>
+#include <test.hpp>
+
+static void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m, {migraphx::mark_state_writes{}, migraphx::dead_code_elimination{}});
+}
+
+static bool is_inplace(migraphx::instruction_ref ins)
+{
+    return ins->get_operator().to_value()["inplace"].to<bool>();
+}
+
+static migraphx::instruction_ref find_write(const migraphx::module& m)
+{
+    return std::find_if(
+        m.begin(), m.end(), [](const auto& ins) { return ins.name() == "tensor_scatter"; });
+}
+
+TEST_CASE(state_write)
+{
+    migraphx::shape cs{migraphx::shape::float_type, {2, 4, 3}};
+    migraphx::shape us{migraphx::shape::float_type, {2, 1, 3}};
+    migraphx::module m;
+    auto x = m.add_parameter("x", cs);
+    auto u = m.add_parameter("u", us);
+    auto k = m.add_state("k", cs);
+    m.add_instruction(migraphx::make_op("tensor_scatter", {{"axis", 1}}), k, u);
+    m.add_return({m.add_instruction(migraphx::make_op("neg"), x)});
+    run_pass(m);
+    auto w = find_write(m);
+    EXPECT(bool{w != m.end()});
+    EXPECT(is_inplace(w));
+    EXPECT(bool{w->inputs().front() == k});
+    EXPECT(w->inputs().size() == 3);
+    EXPECT(bool{migraphx::instruction::get_output_alias(w) == k});
+}
+
+TEST_CASE(param_write)
+{
+    migraphx::shape cs{migraphx::shape::float_type, {2, 4, 3}};
+    migraphx::shape us{migraphx::shape::float_type, {2, 1, 3}};
+    migraphx::module m;
+    auto x = m.add_parameter("x", cs);
+    auto u = m.add_parameter("u", us);
+    auto w = m.add_instruction(migraphx::make_op("tensor_scatter", {{"axis", 1}}), x, u);
+    m.add_return({w});
+    run_pass(m);
+    EXPECT(not is_inplace(w));
+    EXPECT(w->inputs().size() == 2);
+    EXPECT(bool{migraphx::instruction::get_output_alias(w) == w});
+}
+
+TEST_CASE(state_read_before_write)
+{
+    migraphx::shape cs{migraphx::shape::float_type, {2, 4, 3}};
+    migraphx::shape us{migraphx::shape::float_type, {2, 1, 3}};
+    migraphx::module m;
+    auto u     = m.add_parameter("u", us);
+    auto k1    = m.add_state("k", cs);
+    auto k2    = m.add_state("k", cs);
+    auto slice = m.add_instruction(
+        migraphx::make_op("slice", {{"axes", {1}}, {"starts", {0}}, {"ends", {2}}}), k1);
+    auto read = m.add_instruction(migraphx::make_op("neg"), slice);
+    m.add_instruction(migraphx::make_op("tensor_scatter", {{"axis", 1}}), k2, u);
+    m.add_return({read});
+    run_pass(m);
+    auto w = find_write(m);
+    EXPECT(bool{w != m.end()});
+    EXPECT(bool{w->inputs().front() == k2});
+    EXPECT(migraphx::contains(w->inputs(), slice));
+    EXPECT(migraphx::contains(w->inputs(), read));
+}
+
+TEST_CASE(state_read_after_write)
+{
+    migraphx::shape cs{migraphx::shape::float_type, {2, 4, 3}};
+    migraphx::shape us{migraphx::shape::float_type, {2, 1, 3}};
+    migraphx::shape is{migraphx::shape::int64_type, {2}};
+    migraphx::module m;
+    auto u1 = m.add_parameter("u1", us);
+    auto u2 = m.add_parameter("u2", us);
+    auto i  = m.add_parameter("i", is);
+    auto k1 = m.add_state("k", cs);
+    auto k2 = m.add_state("k", cs);
+    auto k3 = m.add_state("k", cs);
+    auto w1 = m.add_instruction(migraphx::make_op("tensor_scatter", {{"axis", 1}}), k1, u1, i);
+    auto w2 = m.add_instruction(migraphx::make_op("tensor_scatter", {{"axis", 1}}), k2, u2, i);
+    auto read = m.add_instruction(migraphx::make_op("neg"), k3);
+    m.add_return({read});
+    run_pass(m);
+    EXPECT(is_inplace(w1));
+    EXPECT(is_inplace(w2));
+    EXPECT(bool{w2->inputs().front() == w1});
+    EXPECT(bool{read->inputs().front() == w2});
+    EXPECT(bool{migraphx::instruction::get_output_alias(w2) == k1});
+}
+
+TEST_CASE(state_view_used_after_write)
+{
+    migraphx::shape cs{migraphx::shape::float_type, {2, 4, 3}};
+    migraphx::shape us{migraphx::shape::float_type, {2, 1, 3}};
+    migraphx::shape qs{migraphx::shape::float_type, {2, 3, 2}};
+    migraphx::module m;
+    auto u     = m.add_parameter("u", us);
+    auto q     = m.add_parameter("q", qs);
+    auto k1    = m.add_state("k", cs);
+    auto k2    = m.add_state("k", cs);
+    auto slice = m.add_instruction(
+        migraphx::make_op("slice", {{"axes", {1}}, {"starts", {0}}, {"ends", {2}}}), k1);
+    m.add_instruction(migraphx::make_op("tensor_scatter", {{"axis", 1}}), k2, u);
+    auto dot = m.add_instruction(migraphx::make_op("dot"), slice, q);
+    m.add_return({dot});
+    run_pass(m);
+    auto w = find_write(m);
+    EXPECT(bool{w != m.end()});
+    // the dot reads the state after the write, so it uses a view of the write
+    auto view = dot->inputs().front();
+    EXPECT(bool{view != slice});
+    EXPECT(view->get_operator() == slice->get_operator());
+    EXPECT(bool{view->inputs().front() == w});
+    EXPECT(not migraphx::contains(w->inputs(), dot));
+    EXPECT(std::distance(m.begin(), w) < std::distance(m.begin(), view));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
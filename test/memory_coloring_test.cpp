@@ -26,6 +26,8 @@
 #include <migraphx/check_shapes.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/instruction.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
 #include <migraphx/make_op.hpp>
 #include <basic_ops.hpp>
 #include <test.hpp>
@@ -725,9 +727,10 @@ TEST_CASE(test39)
         run_pass(*smod);
     }
 
-    CHECK(mm->get_parameter_shape("scratch").bytes() == 1);
-    CHECK(then_mod->get_parameter_shape("scratch").bytes() == 24);
-    CHECK(else_mod->get_parameter_shape("scratch").bytes() == 24);
+    // The branch scratch is folded into the main module's scratch
+    CHECK(mm->get_parameter_shape("scratch").bytes() == 32);
+    CHECK(not migraphx::contains(then_mod->get_parameter_names(), "scratch"));
+    CHECK(not migraphx::contains(else_mod->get_parameter_names(), "scratch"));
     CHECK(no_allocate(*mm));
     CHECK(no_allocate(*then_mod));
     CHECK(no_allocate(*else_mod));
@@ -3805,4 +3808,57 @@ TEST_CASE(test_tuple)
     CHECK(is_disjoint({a1, a2}));
 }
 
+migraphx::module_ref add_branch(migraphx::program& p, const std::string& name, std::size_t n)
+{
+    auto* m = p.create_module(name);
+    std::vector<migraphx::instruction_ref> allocs;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        auto a = add_alloc(*m, {migraphx::shape::float_type, {40}});
+        allocs.push_back(m->add_instruction(pass_op{}, a));
+    }
+    m->add_return({m->add_instruction(pass_op{}, allocs)});
+    return m;
+}
+
+TEST_CASE(submodule_shared_scratch)
+{
+    migraphx::program p;
+    auto* mm  = p.get_main_module();
+    auto cond = mm->add_parameter("cond", {migraphx::shape::bool_type, {1}});
+    auto a1   = add_alloc(*mm, {migraphx::shape::float_type, {8}});
+    auto p1   = mm->add_instruction(pass_op{}, a1);
+    auto* then_mod = add_branch(p, "then", 2);
+    auto* else_mod = add_branch(p, "else", 1);
+    auto r = mm->add_instruction(migraphx::make_op("if"), {cond}, {then_mod, else_mod});
+    mm->add_instruction(pass_op{}, r, p1);
+    migraphx::run_passes(p, {migraphx::memory_coloring{"allocate", true}});
+    auto nested = std::prev(r);
+    CHECK(not migraphx::contains(then_mod->get_parameter_names(), "scratch"));
+    CHECK(not migraphx::contains(else_mod->get_parameter_names(), "scratch"));
+    CHECK(no_allocate(*mm));
+    CHECK(no_allocate(*then_mod));
+    CHECK(no_allocate(*else_mod));
+    // Both branches share the same region, which can't overlap a1 since it is live across the if
+    CHECK(mm->get_parameter_shape("scratch").bytes() == 352);
+    CHECK(is_disjoint({a1, nested}));
+}
+
+TEST_CASE(submodule_reuse_parent_scratch)
+{
+    migraphx::program p;
+    auto* mm  = p.get_main_module();
+    auto cond = mm->add_parameter("cond", {migraphx::shape::bool_type, {1}});
+    auto a1   = add_alloc(*mm, {migraphx::shape::float_type, {80}});
+    mm->add_instruction(pass_op{}, a1);
+    auto* then_mod = add_branch(p, "then", 2);
+    auto* else_mod = add_branch(p, "else", 1);
+    auto r = mm->add_instruction(migraphx::make_op("if"), {cond}, {then_mod, else_mod});
+    mm->add_instruction(pass_op{}, r);
+    migraphx::run_passes(p, {migraphx::memory_coloring{"allocate", true}});
+    CHECK(no_allocate(*mm));
+    // a1 is dead before the if runs, so its memory is reused by the branches
+    CHECK(mm->get_parameter_shape("scratch").bytes() == 320);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -26,7 +26,20 @@
 
 TEST_CASE(resize_linear_non_const_test)
 {
-    // runtime (non-constant) input is only supported in "nearest" mode
-    migraphx::onnx_options options;
-    EXPECT(test::throws([&] { read_onnx("resize_linear_non_const_test.onnx", options); }));
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape sx{migraphx::shape::float_type, {1, 1, 2, 4}};
+    migraphx::shape ss{migraphx::shape::float_type, {4}};
+    auto x      = mm->add_parameter("X", sx);
+    auto scales = mm->add_parameter("scales", ss);
+    mm->add_instruction(migraphx::make_op("undefined"));
+    auto r = mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"mode", "linear"}, {"coordinate_transformation_mode", "half_pixel"}}),
+        x,
+        scales);
+    mm->add_return({r});
+
+    auto prog = read_onnx("resize_linear_non_const_test.onnx");
+    EXPECT(p == prog);
 }
@@ -4641,6 +4641,45 @@ TEST_CASE(test_unique_axis_negative)
         migraphx::shape(y_dyn_shape), migraphx::make_op("unique", {{"axis", -3}}), x_shape);
 }
 
+TEST_CASE(test_tensor_scatter)
+{
+    migraphx::shape cache{migraphx::shape::float_type, {2, 4, 16, 8}};
+    migraphx::shape update{migraphx::shape::float_type, {2, 4, 1, 8}};
+    migraphx::shape indices{migraphx::shape::int64_type, {2}};
+    expect_shape(cache, migraphx::make_op("tensor_scatter"), cache, update, indices);
+    expect_shape(cache, migraphx::make_op("tensor_scatter"), cache, update);
+    expect_shape(cache, migraphx::make_op("tensor_scatter", {{"axis", 2}}), cache, cache);
+    expect_shape(cache,
+                 migraphx::make_op("tensor_scatter", {{"inplace", true}}),
+                 cache,
+                 update,
+                 indices,
+                 update,
+                 cache);
+}
+
+TEST_CASE(test_tensor_scatter_errors)
+{
+    migraphx::shape cache{migraphx::shape::float_type, {2, 4, 16, 8}};
+    migraphx::shape update{migraphx::shape::float_type, {2, 4, 1, 8}};
+    throws_shape(migraphx::make_op("tensor_scatter", {{"axis", 0}}), cache, update);
+    throws_shape(migraphx::make_op("tensor_scatter", {{"axis", 1}}), cache, update);
+    throws_shape(migraphx::make_op("tensor_scatter", {{"mode", "wrap"}}), cache, update);
+    throws_shape(migraphx::make_op("tensor_scatter"), update, cache);
+    throws_shape(migraphx::make_op("tensor_scatter"),
+                 cache,
+                 migraphx::shape{migraphx::shape::half_type, {2, 4, 1, 8}});
+    throws_shape(migraphx::make_op("tensor_scatter"),
+                 cache,
+                 update,
+                 migraphx::shape{migraphx::shape::int64_type, {4}});
+    throws_shape(migraphx::make_op("tensor_scatter"),
+                 cache,
+                 update,
+                 migraphx::shape{migraphx::shape::int64_type, {2}},
+                 update);
+}
+
 TEST_CASE(test_unique_axis_none)
 {
     migraphx::shape x_shape{migraphx::shape::half_type, {10, 4, 3}};
@@ -50,4 +50,22 @@ TEST_CASE(perf_report)
     EXPECT(not migraphx::contains(output, "fast"));
 }
 
+TEST_CASE(time_instructions)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    auto one = mm->add_literal(1);
+    auto two = mm->add_literal(2);
+    mm->add_instruction(migraphx::make_op("add"), one, two);
+    p.compile(migraphx::make_target("ref"));
+    auto samples = p.time_instructions(3, {});
+
+    auto sum = std::prev(mm->end());
+    EXPECT(migraphx::contains(samples, sum));
+    EXPECT(samples.at(sum).size() == 3);
+    EXPECT(std::all_of(
+        samples.begin(), samples.end(), [](const auto& x) { return x.second.size() == 3; }));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,162 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/prefix_scan.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <vector>
+#include "test.hpp"
+
+static std::vector<int> blocked_sum(const std::vector<int>& x, std::size_t nblocks, bool exclusive)
+{
+    auto result = x;
+    migraphx::block_scan(
+        result.size(),
+        nblocks,
+        0,
+        [](int a, int b) { return a + b; },
+        [&](std::size_t first, std::size_t last) {
+            return std::accumulate(result.begin() + first, result.begin() + last, 0);
+        },
+        [&](std::size_t first, std::size_t last, int acc) {
+            for(std::size_t i = first; i < last; i++)
+            {
+                auto y    = result[i];
+                result[i] = exclusive ? acc : acc + y;
+                acc += y;
+            }
+        });
+    return result;
+}
+
+TEST_CASE(block_scan_inclusive)
+{
+    std::vector<int> x(1000);
+    std::iota(x.begin(), x.end(), -300);
+    std::vector<int> gold(x.size());
+    std::partial_sum(x.begin(), x.end(), gold.begin());
+    for(std::size_t nblocks : {0, 1, 2, 3, 7, 64, 999, 1000, 5000})
+        EXPECT(blocked_sum(x, nblocks, false) == gold);
+}
+
+TEST_CASE(block_scan_exclusive)
+{
+    std::vector<int> x(777);
+    std::iota(x.begin(), x.end(), 1);
+    std::vector<int> gold(x.size());
+    std::exclusive_scan(x.begin(), x.end(), gold.begin(), 0);
+    for(std::size_t nblocks : {1, 4, 13, 777})
+        EXPECT(blocked_sum(x, nblocks, true) == gold);
+}
+
+TEST_CASE(block_scan_empty)
+{
+    std::vector<int> x;
+    for(std::size_t nblocks : {0, 1, 4})
+        EXPECT(blocked_sum(x, nblocks, false).empty());
+}
+
+TEST_CASE(block_scan_compact)
+{
+    std::vector<int> x(500);
+    std::iota(x.begin(), x.end(), 0);
+    std::vector<int> gold;
+    std::copy_if(x.begin(), x.end(), std::back_inserter(gold), [](int i) { return i % 3 == 0; });
+    for(std::size_t nblocks : {1, 3, 8, 500})
+    {
+        std::vector<int> result(gold.size(), -1);
+        migraphx::block_scan(
+            x.size(),
+            nblocks,
+            std::size_t{0},
+            [](std::size_t a, std::size_t b) { return a + b; },
+            [&](std::size_t first, std::size_t last) {
+                return std::size_t(std::count_if(
+                    x.begin() + first, x.begin() + last, [](int i) { return i % 3 == 0; }));
+            },
+            [&](std::size_t first, std::size_t last, std::size_t k) {
+                for(std::size_t i = first; i < last; i++)
+                {
+                    if(x[i] % 3 == 0)
+                        result[k++] = x[i];
+                }
+            });
+        EXPECT(result == gold);
+    }
+}
+
+TEST_CASE(prefix_scan_strided)
+{
+    std::vector<int> x(2 * 5000, 1);
+    migraphx::prefix_scan(x.data() + 1, 5000, 2, false, [](int a, int b) { return a + b; });
+    for(int i = 0; i < 5000; i++)
+    {
+        EXPECT(x[2 * i] == 1);
+        EXPECT(x[2 * i + 1] == i + 1);
+    }
+}
+
+TEST_CASE(prefix_scan_reverse_exclusive)
+{
+    std::vector<int> x(9000, 2);
+    migraphx::prefix_scan(x.data() + x.size() - 1, x.size(), -1, true, std::plus<>{});
+    for(int i = 0; i < 9000; i++)
+        EXPECT(x[i] == 2 * (8999 - i));
+}
+
+TEST_CASE(prefix_scan_rows_blocks)
+{
+    // Rows interleaved along the inner dimension, with both rows and blocks in parallel
+    for(std::size_t nrows : {1, 2, 3, 64})
+    {
+        std::size_t n = 20000;
+        std::vector<int> x(nrows * n, 1);
+        std::vector<int> gold(x.size());
+        for(std::size_t i = 0; i < gold.size(); i++)
+            gold[i] = int(i / nrows) + 1;
+        for(std::size_t nblocks : {1, 2, 5})
+        {
+            std::fill(x.begin(), x.end(), 1);
+            migraphx::block_scan_rows(
+                nrows,
+                n,
+                nblocks,
+                0,
+                std::plus<>{},
+                [&](std::size_t, std::size_t first, std::size_t last) { return int(last - first); },
+                [&](std::size_t r, std::size_t first, std::size_t last, int acc) {
+                    for(std::size_t i = first; i < last; i++)
+                        x[i * nrows + r] = ++acc;
+                });
+            EXPECT(x == gold);
+        }
+        std::fill(x.begin(), x.end(), 1);
+        migraphx::prefix_scan_rows(
+            nrows, [&](std::size_t r) { return x.data() + r; }, n, nrows, false, std::plus<>{});
+        EXPECT(x == gold);
+    }
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,156 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+
+static std::vector<float> run_attention_test(migraphx::program p)
+{
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    return results_vector;
+}
+
+// softmax(q * kt * scale + mask) * v computed op by op
+static migraphx::instruction_ref add_attention_gold(migraphx::module& m,
+                                                    migraphx::instruction_ref q,
+                                                    migraphx::instruction_ref kt,
+                                                    migraphx::instruction_ref v,
+                                                    float scale,
+                                                    std::optional<migraphx::instruction_ref> mask)
+{
+    auto scores = m.add_instruction(migraphx::make_op("dot"), q, kt);
+    auto lscale = m.add_literal(migraphx::literal{{migraphx::shape::float_type}, {scale}});
+    auto bscale = m.add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", scores->get_shape().lens()}}), lscale);
+    scores = m.add_instruction(migraphx::make_op("mul"), scores, bscale);
+    if(mask.has_value())
+        scores = m.add_instruction(migraphx::make_op("add"), scores, *mask);
+    auto axis = scores->get_shape().ndim() - 1;
+    auto p    = m.add_instruction(migraphx::make_op("softmax", {{"axis", axis}}), scores);
+    return m.add_instruction(migraphx::make_op("dot"), p, v);
+}
+
+static void check_attention(const std::vector<std::size_t>& batch,
+                            std::size_t m,
+                            std::size_t n,
+                            std::size_t k,
+                            std::size_t o,
+                            bool with_mask,
+                            bool causal)
+{
+    auto lens = [&](std::size_t x, std::size_t y) {
+        auto result = batch;
+        result.push_back(x);
+        result.push_back(y);
+        return result;
+    };
+    migraphx::shape::type_t t = migraphx::shape::float_type;
+    auto lq                   = migraphx::generate_literal({t, lens(m, k)}, 1);
+    // The keys are stored transposed, as they are in models
+    auto lk    = migraphx::generate_literal({t, lens(n, k)}, 2);
+    auto lv    = migraphx::generate_literal({t, lens(n, o)}, 3);
+    auto lmask = migraphx::generate_literal({t, lens(m, n)}, 4);
+    if(causal)
+    {
+        migraphx::shape mask_shape{t, lens(m, n)};
+        std::vector<float> mask_data(mask_shape.elements());
+        for(std::size_t i = 0; i < mask_data.size(); i++)
+        {
+            auto idx     = mask_shape.multi(i);
+            auto row     = idx[idx.size() - 2];
+            auto col     = idx[idx.size() - 1];
+            mask_data[i] = col + m > row + n ? -std::numeric_limits<float>::infinity() : 0.0f;
+        }
+        lmask = migraphx::literal{mask_shape, mask_data};
+    }
+    std::vector<int64_t> perm(batch.size() + 2);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::swap(perm[perm.size() - 1], perm[perm.size() - 2]);
+    float scale = 1.0f / std::sqrt(float(k));
+
+    migraphx::program p1;
+    auto* mm1 = p1.get_main_module();
+    auto kt1  = mm1->add_instruction(migraphx::make_op("transpose", {{"permutation", perm}}),
+                                    mm1->add_literal(lk));
+    std::optional<migraphx::instruction_ref> mask1;
+    if(with_mask or causal)
+        mask1 = mm1->add_literal(lmask);
+    add_attention_gold(*mm1, mm1->add_literal(lq), kt1, mm1->add_literal(lv), scale, mask1);
+    auto gold = run_attention_test(p1);
+
+    migraphx::program p2;
+    auto* mm2 = p2.get_main_module();
+    auto kt2  = mm2->add_instruction(migraphx::make_op("transpose", {{"permutation", perm}}),
+                                    mm2->add_literal(lk));
+    std::vector<migraphx::instruction_ref> inputs = {mm2->add_literal(lq), kt2};
+    if(with_mask)
+        inputs.push_back(mm2->add_literal(lmask));
+    inputs.push_back(mm2->add_literal(lv));
+    mm2->add_instruction(
+        migraphx::make_op("attention", {{"scale", scale}, {"causal", causal}}), inputs);
+    auto results_vector = run_attention_test(p2);
+
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
+TEST_CASE(attention_test) { check_attention({2, 3}, 5, 7, 4, 6, false, false); }
+
+TEST_CASE(attention_mask_test) { check_attention({2}, 9, 9, 8, 8, true, false); }
+
+TEST_CASE(attention_causal_test) { check_attention({2}, 9, 9, 8, 8, false, true); }
+
+TEST_CASE(attention_causal_offset_test) { check_attention({1, 2}, 3, 11, 5, 4, false, true); }
+
+// Spans several query and key blocks
+TEST_CASE(attention_blocks_test) { check_attention({2}, 37, 150, 16, 8, true, false); }
+
+TEST_CASE(attention_causal_blocks_test) { check_attention({1}, 70, 70, 8, 8, false, true); }
+
+TEST_CASE(attention_shape_test)
+{
+    migraphx::shape q{migraphx::shape::float_type, {2, 3, 5, 4}};
+    migraphx::shape kt{migraphx::shape::float_type, {2, 3, 4, 7}};
+    migraphx::shape mask{migraphx::shape::float_type, {2, 3, 5, 7}};
+    migraphx::shape v{migraphx::shape::float_type, {2, 3, 7, 6}};
+    auto op = migraphx::make_op("attention");
+    EXPECT(op.compute_shape({q, kt, v}) ==
+           migraphx::shape{migraphx::shape::float_type, {2, 3, 5, 6}});
+    EXPECT(op.compute_shape({q, kt, mask, v}) ==
+           migraphx::shape{migraphx::shape::float_type, {2, 3, 5, 6}});
+    EXPECT(test::throws([&] { op.compute_shape({q, v, v}); }));
+    EXPECT(test::throws([&] { op.compute_shape({q, kt, q, v}); }));
+}
@@ -102,3 +102,78 @@ TEST_CASE(contiguous_dyn_test)
     std::vector<float> gold = {0, 3, 6, 9, 1, 4, 7, 10, 2, 5, 8, 11};
     EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
 }
+
+static void check_contiguous(const migraphx::shape& s,
+                             const std::vector<migraphx::operation>& ops,
+                             const migraphx::operation& copy_op = migraphx::make_op("contiguous"))
+{
+    migraphx::program p;
+    auto* mm  = p.get_main_module();
+    auto view = mm->add_parameter("X", s);
+    for(const auto& op : ops)
+        view = mm->add_instruction(op, view);
+    auto copy = mm->add_instruction(copy_op, view);
+    mm->add_return({view, copy});
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 0);
+    migraphx::parameter_map params;
+    params["X"]  = migraphx::argument(s, data.data());
+    auto results = p.eval(params);
+
+    std::vector<float> gold;
+    results[0].visit([&](auto output) { gold.assign(output.begin(), output.end()); });
+    std::vector<float> results_vector;
+    results[1].visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    EXPECT(results[1].get_shape().lens() == results[0].get_shape().lens());
+    EXPECT(results_vector == gold);
+}
+
+TEST_CASE(contiguous_transpose_tiled_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {3, 45, 70}};
+    check_contiguous(s, {migraphx::make_op("transpose", {{"permutation", {0, 2, 1}}})});
+}
+
+TEST_CASE(contiguous_nchw_to_nhwc_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 8, 9, 33}};
+    check_contiguous(s, {migraphx::make_op("transpose", {{"permutation", {0, 2, 3, 1}}})});
+}
+
+TEST_CASE(contiguous_slice_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 50, 40}};
+    check_contiguous(
+        s,
+        {migraphx::make_op("slice", {{"axes", {1, 2}}, {"starts", {3, 5}}, {"ends", {47, 40}}})});
+}
+
+TEST_CASE(contiguous_slice_transpose_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 50, 40}};
+    check_contiguous(
+        s,
+        {migraphx::make_op("slice", {{"axes", {0}}, {"starts", {1}}, {"ends", {3}}}),
+         migraphx::make_op("transpose", {{"permutation", {2, 0, 1}}})});
+}
+
+TEST_CASE(contiguous_broadcast_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {5, 1}};
+    check_contiguous(s, {migraphx::make_op("multibroadcast", {{"out_lens", {5, 300}}})});
+}
+
+TEST_CASE(contiguous_large_copy_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {3, 70000}};
+    check_contiguous(s,
+                     {migraphx::make_op("slice", {{"axes", {0}}, {"starts", {1}}, {"ends", {3}}})});
+}
+
+TEST_CASE(layout_nhwc_test)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 8, 9, 33}};
+    check_contiguous(s, {}, migraphx::make_op("layout", {{"permutation", {0, 2, 3, 1}}}));
+}
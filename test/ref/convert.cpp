@@ -27,6 +27,7 @@
 #include <migraphx/program.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/verify.hpp>
+#include <numeric>
 
 #include <test.hpp>
 
@@ -139,3 +140,34 @@ TEST_CASE(convert_nan_convert_updown_test)
     EXPECT(std::all_of(
         results_vector.begin(), results_vector.end(), [](const auto& x) { return std::isnan(x); }));
 }
+
+TEST_CASE(convert_fp8_layout_test)
+{
+    // A transposed input is converted in memory order, and a sliced one element by element
+    migraphx::shape s{migraphx::shape::float_type, {4, 6}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), -11.7f);
+    for(bool sliced : {false, true})
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto l   = mm->add_literal(migraphx::literal{s, data});
+        auto op  = sliced
+                       ? migraphx::make_op("slice", {{"axes", {1}}, {"starts", {1}}, {"ends", {4}}})
+                       : migraphx::make_op("transpose", {{"permutation", {1, 0}}});
+        auto x   = mm->add_instruction(op, l);
+        auto xs  = x->get_shape();
+        mm->add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::fp8e4m3fnuz_type}}), x);
+        p.compile(migraphx::make_target("ref"));
+        auto result = p.eval({}).back();
+        std::vector<float> results_vector;
+        result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+
+        std::vector<float> gold;
+        std::size_t offset = sliced ? 1 : 0;
+        for(std::size_t i = 0; i < xs.elements(); i++)
+            gold.push_back(migraphx::fp8::fp8e4m3fnuz(data[offset + xs.index(i)]));
+        EXPECT(results_vector == gold);
+    }
+}
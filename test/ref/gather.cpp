@@ -284,3 +284,72 @@ TEST_CASE(gather_dyn_test1)
     migraphx::shape sfinal{migraphx::shape::int32_type, {1, 2, 4}};
     EXPECT(result.get_shape() == sfinal);
 }
+
+TEST_CASE(gather_embedding_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {1000, 64}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 0);
+    auto a0 = mm->add_literal(migraphx::literal{s, data});
+    migraphx::shape s_indices{migraphx::shape::int32_type, {2, 3}};
+    std::vector<int> indices{999, 0, -1, 17, -1000, 17};
+    auto a1 = mm->add_literal(migraphx::literal{s_indices, indices});
+    mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), a0, a1);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> gold;
+    for(auto i : indices)
+    {
+        auto row = (i < 0) ? i + 1000 : i;
+        gold.insert(gold.end(), data.begin() + row * 64, data.begin() + (row + 1) * 64);
+    }
+    std::vector<float> res_data;
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(res_data == gold);
+}
+
+TEST_CASE(gather_middle_axis_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::int32_type, {3, 5, 4}};
+    std::vector<int> data(s.elements());
+    std::iota(data.begin(), data.end(), 0);
+    auto a0 = mm->add_literal(migraphx::literal{s, data});
+    migraphx::shape s_indices{migraphx::shape::int64_type, {2}};
+    std::vector<int64_t> indices{4, -5};
+    auto a1 = mm->add_literal(migraphx::literal{s_indices, indices});
+    mm->add_instruction(migraphx::make_op("gather", {{"axis", 1}}), a0, a1);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<int> gold;
+    for(int i = 0; i < 3; i++)
+    {
+        for(int j : {4, 0})
+        {
+            for(int k = 0; k < 4; k++)
+                gold.push_back(i * 20 + j * 4 + k);
+        }
+    }
+    std::vector<int> res_data;
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(res_data == gold);
+    EXPECT(result.get_shape().lens() == std::vector<std::size_t>{3, 2, 4});
+}
+
+TEST_CASE(gather_out_of_bounds_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4, 2}};
+    auto a0 = mm->add_literal(migraphx::literal{s, std::vector<float>(8, 1)});
+    migraphx::shape s_indices{migraphx::shape::int32_type, {2}};
+    auto a1 = mm->add_literal(migraphx::literal{s_indices, std::vector<int>{1, 4}});
+    mm->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), a0, a1);
+    p.compile(migraphx::make_target("ref"));
+    EXPECT(test::throws([&] { p.eval({}); }));
+}
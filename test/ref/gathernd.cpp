@@ -406,3 +406,30 @@ TEST_CASE(gathernd_negative_index_test_2)
 
     EXPECT(test::throws([&] { p.eval({}); }));
 }
+
+TEST_CASE(gathernd_transposed_data_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    migraphx::shape ds{migraphx::shape::float_type, {3, 4, 2}};
+    migraphx::shape is{migraphx::shape::int64_type, {2, 1}};
+
+    std::vector<float> data_vec(3 * 4 * 2);
+    std::iota(data_vec.begin(), data_vec.end(), 0);
+    std::vector<int64_t> indices_vec{1, -2};
+
+    auto data = mm->add_literal(migraphx::literal{ds, data_vec});
+    auto tr =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0, 2}}}), data);
+    auto indices = mm->add_literal(migraphx::literal{is, indices_vec});
+
+    mm->add_instruction(migraphx::make_op("gathernd"), tr, indices);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> res_data{};
+    std::vector<float> gold{2, 3, 10, 11, 18, 19, 4, 5, 12, 13, 20, 21};
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+
+    EXPECT(migraphx::verify::verify_rms_range(res_data, gold));
+}
@@ -343,3 +343,109 @@ TEST_CASE(nms_transpose2_test)
     std::vector<int64_t> gold = {0, 0, 3, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0};
     EXPECT(migraphx::verify::verify_rms_range(result, gold));
 }
+
+// Straightforward greedy NMS on [y1, x1, y2, x2] boxes, used as a reference for larger inputs
+static std::vector<int64_t> naive_nms(const std::vector<float>& boxes,
+                                      const std::vector<float>& scores,
+                                      std::size_t num_batches,
+                                      std::size_t num_classes,
+                                      std::size_t num_boxes,
+                                      std::size_t max_out,
+                                      double iou_threshold,
+                                      double score_threshold)
+{
+    auto iou = [&](std::size_t b, std::size_t i, std::size_t j) {
+        const auto* p = boxes.data() + (b * num_boxes + i) * 4;
+        const auto* q = boxes.data() + (b * num_boxes + j) * 4;
+        double py0 = std::min(p[0], p[2]), py1 = std::max(p[0], p[2]);
+        double px0 = std::min(p[1], p[3]), px1 = std::max(p[1], p[3]);
+        double qy0 = std::min(q[0], q[2]), qy1 = std::max(q[0], q[2]);
+        double qx0 = std::min(q[1], q[3]), qx1 = std::max(q[1], q[3]);
+        double w   = std::min(px1, qx1) - std::max(px0, qx0);
+        double h   = std::min(py1, qy1) - std::max(py0, qy0);
+        if(w < 0 or h < 0)
+            return 0.0;
+        double a1 = (px1 - px0) * (py1 - py0);
+        double a2 = (qx1 - qx0) * (qy1 - qy0);
+        if(a1 <= 0 or a2 <= 0)
+            return 0.0;
+        return w * h / (a1 + a2 - w * h);
+    };
+    std::vector<int64_t> result;
+    for(std::size_t b = 0; b < num_batches; b++)
+    {
+        for(std::size_t c = 0; c < num_classes; c++)
+        {
+            const auto* sc = scores.data() + (b * num_classes + c) * num_boxes;
+            std::vector<std::pair<double, int64_t>> order;
+            for(std::size_t i = 0; i < num_boxes; i++)
+            {
+                if(score_threshold <= 0 or sc[i] >= score_threshold)
+                    order.emplace_back(sc[i], i);
+            }
+            std::sort(order.begin(), order.end(), std::greater<>{});
+            std::vector<int64_t> selected;
+            for(auto [score, i] : order)
+            {
+                if(selected.size() >= max_out)
+                    break;
+                if(std::none_of(selected.begin(), selected.end(), [&](auto j) {
+                       return iou(b, i, j) > iou_threshold;
+                   }))
+                    selected.push_back(i);
+            }
+            for(auto i : selected)
+                result.insert(result.end(), {int64_t(b), int64_t(c), i});
+        }
+    }
+    return result;
+}
+
+TEST_CASE(nms_many_boxes_test)
+{
+    const std::size_t num_batches = 2;
+    const std::size_t num_classes = 3;
+    const std::size_t num_boxes   = 500;
+    const std::size_t max_out     = 40;
+    std::vector<float> boxes_vec(num_batches * num_boxes * 4);
+    std::vector<float> scores_vec(num_batches * num_classes * num_boxes);
+    for(std::size_t i = 0; i < num_batches * num_boxes; i++)
+    {
+        float y = (i * 7919) % 97;
+        float x = (i * 104729) % 89;
+        float h = 2 + (i * 31) % 13;
+        float w = 2 + (i * 17) % 11;
+        // Mix the corner order and include some empty boxes
+        boxes_vec[i * 4 + 0] = i % 5 == 0 ? y + h : y;
+        boxes_vec[i * 4 + 1] = x;
+        boxes_vec[i * 4 + 2] = i % 5 == 0 ? y : y + h;
+        boxes_vec[i * 4 + 3] = i % 23 == 0 ? x : x + w;
+    }
+    for(std::size_t i = 0; i < scores_vec.size(); i++)
+        scores_vec[i] = float((i * 7) % 50) / 50.0f;
+
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape boxes_s{migraphx::shape::float_type, {num_batches, num_boxes, 4}};
+    migraphx::shape scores_s{migraphx::shape::float_type, {num_batches, num_classes, num_boxes}};
+    auto boxes_l         = mm->add_literal(migraphx::literal(boxes_s, boxes_vec));
+    auto scores_l        = mm->add_literal(migraphx::literal(scores_s, scores_vec));
+    auto max_out_l       = mm->add_literal(int64_t{max_out});
+    auto iou_threshold   = mm->add_literal(0.3f);
+    auto score_threshold = mm->add_literal(0.1f);
+    auto r = mm->add_instruction(migraphx::make_op("nonmaxsuppression", {{"use_dyn_output", true}}),
+                                 boxes_l,
+                                 scores_l,
+                                 max_out_l,
+                                 iou_threshold,
+                                 score_threshold);
+    mm->add_return({r});
+
+    p.compile(migraphx::make_target("ref"));
+    auto output = p.eval({}).back();
+    std::vector<int64_t> result;
+    output.visit([&](auto out) { result.assign(out.begin(), out.end()); });
+    auto gold = naive_nms(
+        boxes_vec, scores_vec, num_batches, num_classes, num_boxes, max_out, 0.3f, 0.1f);
+    EXPECT(result == gold);
+}
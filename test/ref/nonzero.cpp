@@ -48,3 +48,34 @@ TEST_CASE(nonzero_test)
                                  1, 1, 0, 0, 0, 0, 0, 1, 0, 2, 0, 2, 0, 2, 0, 0, 0, 0};
     EXPECT(migraphx::verify::verify_rms_range(result_vector, gold));
 }
+
+TEST_CASE(nonzero_large_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::int32_type, {7, 50, 30}};
+    std::vector<int32_t> data(s.elements());
+    for(std::size_t i = 0; i < data.size(); i++)
+        data[i] = (i % 7 == 0 or i % 11 == 3) ? 0 : static_cast<int32_t>(i);
+    auto input = mm->add_literal(migraphx::literal(s, data));
+    auto ret   = mm->add_instruction(migraphx::make_op("nonzero"), input);
+    mm->add_return({ret});
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<int64_t> result_vector;
+    result.visit([&](auto output) { result_vector.assign(output.begin(), output.end()); });
+
+    std::size_t n = s.elements();
+    std::vector<int64_t> gold(3 * n, 0);
+    std::size_t k = 0;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        if(data[i] == 0)
+            continue;
+        auto idx          = s.multi(i);
+        gold[k]           = idx[0];
+        gold[n + k]       = idx[1];
+        gold[2 * n + k++] = idx[2];
+    }
+    EXPECT(result_vector == gold);
+}
@@ -27,6 +27,7 @@
 #include <migraphx/program.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/verify.hpp>
+#include <numeric>
 
 #include <test.hpp>
 
@@ -300,3 +301,47 @@ TEST_CASE(prefix_scan_sum_reverse_2)
     std::vector<float> gold{2.0, 4.0, 6.0, 8.0, 1.0, 2.0, 3.0, 4.0};
     EXPECT(results_vector == gold);
 }
+
+TEST_CASE(prefix_scan_sum_long_axis)
+{
+    // A long scanned axis with a short, transposed batch
+    migraphx::shape s{migraphx::shape::int32_type, {3, 20000}};
+    std::vector<int32_t> data(s.elements());
+    std::iota(data.begin(), data.end(), -30000);
+    for(bool exclusive : {false, true})
+    {
+        for(bool reverse : {false, true})
+        {
+            migraphx::program p;
+            auto* mm = p.get_main_module();
+            auto l0  = mm->add_literal(migraphx::literal{s, data});
+            auto t0 =
+                mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), l0);
+            mm->add_instruction(
+                migraphx::make_op("prefix_scan_sum",
+                                  {{"axis", 0}, {"exclusive", exclusive}, {"reverse", reverse}}),
+                t0);
+            p.compile(migraphx::make_target("ref"));
+            auto result = p.eval({}).back();
+            std::vector<int32_t> results_vector;
+            result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+
+            std::vector<int32_t> gold(s.elements());
+            for(std::size_t row = 0; row < 3; row++)
+            {
+                int32_t acc = 0;
+                for(std::size_t j = 0; j < 20000; j++)
+                {
+                    auto k = reverse ? 19999 - j : j;
+                    auto x = data[row * 20000 + k];
+                    if(not exclusive)
+                        acc += x;
+                    gold[k * 3 + row] = acc;
+                    if(exclusive)
+                        acc += x;
+                }
+            }
+            EXPECT(results_vector == gold);
+        }
+    }
+}
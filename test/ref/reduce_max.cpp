@@ -198,3 +198,23 @@ TEST_CASE(reduce_max_variable_axes02)
     std::vector<float> gold{10, 12};
     EXPECT(results_vector == gold);
 }
+
+TEST_CASE(reduce_max_long_inner_axis)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {1, 50000}};
+    std::vector<float> data(s.elements());
+    for(std::size_t i = 0; i < data.size(); i++)
+        data[i] = -float(i % 13);
+    data[37111] = 5;
+    auto l0     = mm->add_literal(migraphx::literal{s, data});
+    mm->add_instruction(migraphx::make_op("reduce_max", {{"axes", {1}}}), l0);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+
+    std::vector<float> gold{5};
+    EXPECT(results_vector == gold);
+}
@@ -29,6 +29,7 @@
 #include <migraphx/verify.hpp>
 
 #include <test.hpp>
+#include <numeric>
 
 TEST_CASE(reduce_sum_axis0)
 {
@@ -309,3 +310,88 @@ TEST_CASE(reduce_sum_variable_empty_axes)
 
     EXPECT(results_vector == input_data);
 }
+
+static std::vector<float> run_reduce_sum(const migraphx::shape& s,
+                                         const std::vector<float>& data,
+                                         const std::vector<int64_t>& axes,
+                                         const std::vector<int64_t>& perm = {})
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_literal(migraphx::literal{s, data});
+    if(not perm.empty())
+        x = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", perm}}), x);
+    mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", axes}}), x);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    return results_vector;
+}
+
+TEST_CASE(reduce_sum_long_inner_axis)
+{
+    // Few long rows are split across threads
+    migraphx::shape s{migraphx::shape::float_type, {2, 20000}};
+    std::vector<float> data(s.elements());
+    for(std::size_t i = 0; i < data.size(); i++)
+        data[i] = i % 7;
+    std::vector<float> gold(2, 0);
+    for(std::size_t i = 0; i < data.size(); i++)
+        gold[i / 20000] += data[i];
+    EXPECT(run_reduce_sum(s, data, {1}) == gold);
+}
+
+TEST_CASE(reduce_sum_wide_middle_axis)
+{
+    // The inner dimension spans more than one tile of columns
+    migraphx::shape s{migraphx::shape::float_type, {5, 3, 300}};
+    std::vector<float> data(s.elements());
+    for(std::size_t i = 0; i < data.size(); i++)
+        data[i] = i % 11;
+    std::vector<float> gold(5 * 300, 0);
+    for(std::size_t i = 0; i < 5; i++)
+    {
+        for(std::size_t j = 0; j < 3; j++)
+        {
+            for(std::size_t k = 0; k < 300; k++)
+                gold[i * 300 + k] += data[(i * 3 + j) * 300 + k];
+        }
+    }
+    EXPECT(run_reduce_sum(s, data, {1}) == gold);
+}
+
+TEST_CASE(reduce_sum_adjacent_axes)
+{
+    // Adjacent reduced axes are collapsed into a single contiguous reduction
+    migraphx::shape s{migraphx::shape::float_type, {3, 4, 5, 6}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 0);
+    std::vector<float> gold(3 * 4, 0);
+    for(std::size_t i = 0; i < data.size(); i++)
+        gold[i / 30] += data[i];
+    EXPECT(run_reduce_sum(s, data, {2, 3}) == gold);
+}
+
+TEST_CASE(reduce_sum_separate_axes)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 3, 5}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 0);
+    std::vector<float> gold(3, 0);
+    for(std::size_t i = 0; i < data.size(); i++)
+        gold[(i / 5) % 3] += data[i];
+    EXPECT(run_reduce_sum(s, data, {0, 2}) == gold);
+}
+
+TEST_CASE(reduce_sum_transposed)
+{
+    migraphx::shape s{migraphx::shape::float_type, {4, 6}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 0);
+    // Reduce the original first axis through a transposed view
+    std::vector<float> gold(6, 0);
+    for(std::size_t i = 0; i < data.size(); i++)
+        gold[i % 6] += data[i];
+    EXPECT(run_reduce_sum(s, data, {1}, {1, 0}) == gold);
+}
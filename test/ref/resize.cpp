@@ -393,6 +393,125 @@ TEST_CASE(resize_optimize_test)
     EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
 }
 
+TEST_CASE(resize_linear_test)
+{
+    // batch size 1, 1 color channel, resize 2x2 to 4x4
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 2}};
+    auto a0 = mm->add_literal(migraphx::literal{s, {1.0f, 2.0f, 3.0f, 4.0f}});
+    mm->add_instruction(migraphx::make_op("resize",
+                                          {{"scales", {1.0f, 1.0f, 2.0f, 2.0f}},
+                                           {"mode", "linear"},
+                                           {"coordinate_transformation_mode", "half_pixel"}}),
+                        a0);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> res_data(1 * 1 * 4 * 4);
+    // clang-format off
+    std::vector<float> golden = {
+        1.0f,  1.25f, 1.75f, 2.0f,
+        1.5f,  1.75f, 2.25f, 2.5f,
+        2.5f,  2.75f, 3.25f, 3.5f,
+        3.0f,  3.25f, 3.75f, 4.0f};
+    // clang-format on
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
+}
+
+TEST_CASE(resize_linear_align_corners_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 2}};
+    auto a0 = mm->add_literal(migraphx::literal{s, {1.0f, 2.0f, 3.0f, 4.0f}});
+    mm->add_instruction(migraphx::make_op("resize",
+                                          {{"sizes", {1, 1, 4, 4}},
+                                           {"mode", "linear"},
+                                           {"coordinate_transformation_mode", "align_corners"}}),
+                        a0);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> res_data(1 * 1 * 4 * 4);
+    // clang-format off
+    std::vector<float> golden = {
+        1.0f,      4.0f / 3, 5.0f / 3, 2.0f,
+        5.0f / 3,  2.0f,     7.0f / 3, 8.0f / 3,
+        7.0f / 3,  8.0f / 3, 3.0f,     10.0f / 3,
+        3.0f,      10.0f / 3, 11.0f / 3, 4.0f};
+    // clang-format on
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
+}
+
+TEST_CASE(resize_linear_2_input_test)
+{
+    // runtime scales are resolved when the op is evaluated
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 2, 2}};
+    migraphx::shape ss{migraphx::shape::float_type, {4}};
+    auto a0 = mm->add_parameter("X", s);
+    auto a1 = mm->add_parameter("scales", ss);
+    mm->add_instruction(
+        migraphx::make_op("resize",
+                          {{"mode", "linear"}, {"coordinate_transformation_mode", "half_pixel"}}),
+        a0,
+        a1);
+    p.compile(migraphx::make_target("ref"));
+
+    std::vector<float> x_data      = {1.0f, 2.0f, 3.0f, 4.0f};
+    std::vector<float> scales_data = {1.0f, 1.0f, 2.0f, 2.0f};
+    migraphx::parameter_map pp;
+    pp["X"]      = migraphx::argument(s, x_data.data());
+    pp["scales"] = migraphx::argument(ss, scales_data.data());
+    auto result  = p.eval(pp).back();
+
+    std::vector<float> res_data;
+    // clang-format off
+    std::vector<float> golden = {
+        1.0f,  1.25f, 1.75f, 2.0f,
+        1.5f,  1.75f, 2.25f, 2.5f,
+        2.5f,  2.75f, 3.25f, 3.5f,
+        3.0f,  3.25f, 3.75f, 4.0f};
+    // clang-format on
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
+}
+
+TEST_CASE(resize_cubic_test)
+{
+    // resize 4x4 to 2x6 with the default cubic coefficient of -0.75
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    std::vector<float> data(4 * 4);
+    std::iota(data.begin(), data.end(), 0);
+    migraphx::shape s{migraphx::shape::float_type, {1, 1, 4, 4}};
+    auto a0 = mm->add_literal(migraphx::literal{s, data});
+    mm->add_instruction(migraphx::make_op("resize",
+                                          {{"sizes", {1, 1, 2, 6}},
+                                           {"mode", "cubic"},
+                                           {"coordinate_transformation_mode", "half_pixel"}}),
+                        a0);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+
+    std::vector<float> res_data(1 * 1 * 2 * 6);
+    // clang-format off
+    std::vector<float> golden = {
+        1.538194f,  2.03125f,  2.837963f,  3.412037f,  4.21875f,  4.711806f,
+        10.288194f, 10.78125f, 11.587963f, 12.162037f, 12.96875f, 13.461806f};
+    // clang-format on
+    result.visit([&](auto output) { res_data.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(res_data, golden));
+}
+
 TEST_CASE(resize_fail_test_1)
 {
     // invalid resize mode
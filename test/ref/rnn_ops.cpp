@@ -21,14 +21,20 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/generate.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/op/common.hpp>
 #include <migraphx/program.hpp>
+#include <migraphx/pass_manager.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/rewrite_rnn.hpp>
 #include <migraphx/verify.hpp>
 
+#include <algorithm>
+
 #include "test.hpp"
 
 TEST_CASE(rnn_forward)
@@ -8400,3 +8406,154 @@ TEST_CASE(lstm_fp16)
         0.135643,  -0.0566208, 0.142701,   0.0342236,   -0.198664,  0.0702607};
     EXPECT(migraphx::verify::verify_rms_range(hs_data, hs_data_gold, 5e4));
 }
+
+// The ref target keeps lstm and gru, so compare them with the unrolled version of the program
+static void verify_rnn_against_unrolled(const migraphx::program& p)
+{
+    auto unrolled = p;
+    migraphx::run_passes(unrolled, {migraphx::rewrite_rnn{}, migraphx::dead_code_elimination{}});
+    auto native = p;
+    native.compile(migraphx::make_target("ref"));
+    unrolled.compile(migraphx::make_target("ref"));
+    auto* mm = native.get_main_module();
+    EXPECT(std::none_of(
+        mm->begin(), mm->end(), [](const auto& ins) { return ins.name() == "ref::dot"; }));
+
+    auto results      = native.eval({});
+    auto gold_results = unrolled.eval({});
+    EXPECT(results.size() == gold_results.size());
+    for(std::size_t i = 0; i < results.size(); i++)
+    {
+        EXPECT(results[i].get_shape() == gold_results[i].get_shape());
+        std::vector<float> result;
+        std::vector<float> gold;
+        results[i].visit([&](auto output) { result.assign(output.begin(), output.end()); });
+        gold_results[i].visit([&](auto output) { gold.assign(output.begin(), output.end()); });
+        EXPECT(migraphx::verify::verify_rms_range(result, gold));
+    }
+}
+
+TEST_CASE(lstm_native_var_seq_lens)
+{
+    std::size_t batch_size  = 3;
+    std::size_t seq_len     = 5;
+    std::size_t hidden_size = 4;
+    std::size_t input_size  = 3;
+    std::size_t num_dirct   = 2;
+    migraphx::shape in_shape{migraphx::shape::float_type, {seq_len, batch_size, input_size}};
+    migraphx::shape ihc_shape{migraphx::shape::float_type, {num_dirct, batch_size, hidden_size}};
+    migraphx::shape w_shape{migraphx::shape::float_type, {num_dirct, 4 * hidden_size, input_size}};
+    migraphx::shape r_shape{migraphx::shape::float_type, {num_dirct, 4 * hidden_size, hidden_size}};
+    migraphx::shape b_shape{migraphx::shape::float_type, {num_dirct, 8 * hidden_size}};
+    migraphx::shape pph_shape{migraphx::shape::float_type, {num_dirct, 3 * hidden_size}};
+    migraphx::shape sl_shape{migraphx::shape::int32_type, {batch_size}};
+
+    migraphx::program p;
+    auto* mm      = p.get_main_module();
+    auto seq      = mm->add_literal(migraphx::generate_literal(in_shape, 0));
+    auto w        = mm->add_literal(migraphx::generate_literal(w_shape, 1));
+    auto r        = mm->add_literal(migraphx::generate_literal(r_shape, 2));
+    auto bias     = mm->add_literal(migraphx::generate_literal(b_shape, 3));
+    auto ih       = mm->add_literal(migraphx::generate_literal(ihc_shape, 4));
+    auto ic       = mm->add_literal(migraphx::generate_literal(ihc_shape, 5));
+    auto pph      = mm->add_literal(migraphx::generate_literal(pph_shape, 6));
+    auto seq_lens = mm->add_literal(migraphx::literal{sl_shape, {5, 2, 4}});
+    auto hs       = mm->add_instruction(
+        migraphx::make_op(
+            "lstm",
+            {{"hidden_size", hidden_size},
+             {"actv_func",
+              migraphx::to_value(std::vector<migraphx::operation>{migraphx::make_op("sigmoid"),
+                                                                  migraphx::make_op("tanh"),
+                                                                  migraphx::make_op("tanh")})},
+             {"direction", migraphx::to_value(migraphx::op::rnn_direction::bidirectional)}}),
+        seq,
+        w,
+        r,
+        bias,
+        seq_lens,
+        ih,
+        ic,
+        pph);
+    auto last_hs   = mm->add_instruction(migraphx::make_op("rnn_last_hs_output"), hs);
+    auto last_cell = mm->add_instruction(migraphx::make_op("rnn_last_cell_output"), hs);
+    mm->add_return({hs, last_hs, last_cell});
+    verify_rnn_against_unrolled(p);
+}
+
+TEST_CASE(gru_native_var_seq_lens)
+{
+    std::size_t batch_size  = 3;
+    std::size_t seq_len     = 5;
+    std::size_t hidden_size = 4;
+    std::size_t input_size  = 3;
+    std::size_t num_dirct   = 2;
+    migraphx::shape in_shape{migraphx::shape::float_type, {seq_len, batch_size, input_size}};
+    migraphx::shape ih_shape{migraphx::shape::float_type, {num_dirct, batch_size, hidden_size}};
+    migraphx::shape w_shape{migraphx::shape::float_type, {num_dirct, 3 * hidden_size, input_size}};
+    migraphx::shape r_shape{migraphx::shape::float_type, {num_dirct, 3 * hidden_size, hidden_size}};
+    migraphx::shape b_shape{migraphx::shape::float_type, {num_dirct, 6 * hidden_size}};
+    migraphx::shape sl_shape{migraphx::shape::int32_type, {batch_size}};
+
+    for(int linear_before_reset : {0, 1})
+    {
+        migraphx::program p;
+        auto* mm      = p.get_main_module();
+        auto seq      = mm->add_literal(migraphx::generate_literal(in_shape, 0));
+        auto w        = mm->add_literal(migraphx::generate_literal(w_shape, 1));
+        auto r        = mm->add_literal(migraphx::generate_literal(r_shape, 2));
+        auto bias     = mm->add_literal(migraphx::generate_literal(b_shape, 3));
+        auto ih       = mm->add_literal(migraphx::generate_literal(ih_shape, 4));
+        auto seq_lens = mm->add_literal(migraphx::literal{sl_shape, {3, 5, 1}});
+        // leaky_relu is not one of the activations the kernel computes directly
+        auto hs = mm->add_instruction(
+            migraphx::make_op(
+                "gru",
+                {{"hidden_size", hidden_size},
+                 {"actv_func",
+                  migraphx::to_value(std::vector<migraphx::operation>{
+                      migraphx::make_op("sigmoid"),
+                      migraphx::make_op("leaky_relu", {{"alpha", 0.1}}),
+                      migraphx::make_op("sigmoid"),
+                      migraphx::make_op("tanh")})},
+                 {"direction", migraphx::to_value(migraphx::op::rnn_direction::bidirectional)},
+                 {"linear_before_reset", linear_before_reset}}),
+            seq,
+            w,
+            r,
+            bias,
+            seq_lens,
+            ih);
+        auto last_hs = mm->add_instruction(migraphx::make_op("rnn_last_hs_output"), hs);
+        mm->add_return({hs, last_hs});
+        verify_rnn_against_unrolled(p);
+    }
+}
+
+TEST_CASE(lstm_native_reverse_no_optional_inputs)
+{
+    std::size_t batch_size  = 2;
+    std::size_t seq_len     = 6;
+    std::size_t hidden_size = 5;
+    std::size_t input_size  = 3;
+    migraphx::shape in_shape{migraphx::shape::float_type, {seq_len, batch_size, input_size}};
+    migraphx::shape w_shape{migraphx::shape::float_type, {1, 4 * hidden_size, input_size}};
+    migraphx::shape r_shape{migraphx::shape::float_type, {1, 4 * hidden_size, hidden_size}};
+
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto seq = mm->add_literal(migraphx::generate_literal(in_shape, 0));
+    auto w   = mm->add_literal(migraphx::generate_literal(w_shape, 1));
+    auto r   = mm->add_literal(migraphx::generate_literal(r_shape, 2));
+    auto hs  = mm->add_instruction(
+        migraphx::make_op(
+            "lstm",
+            {{"hidden_size", hidden_size},
+             {"direction", migraphx::to_value(migraphx::op::rnn_direction::reverse)}}),
+        seq,
+        w,
+        r);
+    auto last_cell = mm->add_instruction(migraphx::make_op("rnn_last_cell_output"), hs);
+    mm->add_return({hs, last_cell});
+    verify_rnn_against_unrolled(p);
+}
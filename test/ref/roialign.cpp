@@ -28,6 +28,8 @@
 #include <migraphx/op/pooling.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/verify.hpp>
+#include <cmath>
+#include <numeric>
 
 #include <test.hpp>
 
@@ -195,3 +197,50 @@ TEST_CASE(roialign_test)
         EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
     }
 }
+
+TEST_CASE(roialign_nonstandard_input_test)
+{
+    auto run = [](migraphx::op::pooling_mode mode, bool transposed) {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape x_s{migraphx::shape::float_type, {2, 6, 8, 3}};
+        std::vector<float> x_vec(x_s.elements());
+        std::iota(x_vec.begin(), x_vec.end(), 0);
+        std::transform(
+            x_vec.begin(), x_vec.end(), x_vec.begin(), [](auto v) { return std::sin(v); });
+        migraphx::shape roi_s{migraphx::shape::float_type, {4, 4}};
+        std::vector<float> roi_vec = {0, 0, 7, 5, 1, 2, 4, 3.5, 2.5, 0.5, 7.5, 4.5, 3, 1, 3, 1};
+        migraphx::shape ind_s{migraphx::shape::int64_type, {4}};
+        std::vector<int64_t> ind_vec = {1, 0, 1, 0};
+
+        auto x = mm->add_literal(migraphx::literal(x_s, x_vec));
+        x      = mm->add_instruction(
+            migraphx::make_op("transpose", {{"permutation", {0, 3, 1, 2}}}), x);
+        if(not transposed)
+            x = mm->add_instruction(migraphx::make_op("contiguous"), x);
+        auto roi = mm->add_literal(migraphx::literal(roi_s, roi_vec));
+        auto ind = mm->add_literal(migraphx::literal(ind_s, ind_vec));
+        auto r   = mm->add_instruction(migraphx::make_op("roialign",
+                                                       {{"mode", mode},
+                                                        {"output_height", 3},
+                                                        {"output_width", 2},
+                                                        {"sampling_ratio", 0}}),
+                                     x,
+                                     roi,
+                                     ind);
+        mm->add_return({r});
+        p.compile(migraphx::make_target("ref"));
+        auto result = p.eval({}).back();
+        std::vector<float> results_vector;
+        result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+        return results_vector;
+    };
+
+    for(auto mode : {migraphx::op::pooling_mode::average, migraphx::op::pooling_mode::max})
+    {
+        auto result = run(mode, true);
+        auto gold   = run(mode, false);
+        EXPECT(result.size() == 4 * 3 * 3 * 2);
+        EXPECT(result == gold);
+    }
+}
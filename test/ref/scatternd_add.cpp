@@ -104,3 +104,62 @@ TEST_CASE(scatternd_reduction_dyn_test)
                             8, 7, 6, 5, 4,  3,  2,  1,  1,  2,  3,  4,  5,  6,  7,  8};
     EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
 }
+
+TEST_CASE(scatternd_add_slab_test)
+{
+    // each index selects a row, and rows repeat
+    migraphx::program p;
+    auto* mm   = p.get_main_module();
+    auto dtype = migraphx::shape::float_type;
+    auto itype = migraphx::shape::int64_type;
+    migraphx::shape ds{dtype, {4, 3}};
+    migraphx::shape is{itype, {3, 1}};
+    migraphx::shape us{dtype, {3, 3}};
+
+    std::vector<float> data_vec(12, 1);
+    std::vector<int64_t> ind_vec{2, -2, 0};
+    std::vector<float> upd_vec{1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    auto data    = mm->add_literal(migraphx::literal{ds, data_vec});
+    auto indices = mm->add_literal(migraphx::literal{is, ind_vec});
+    auto updates = mm->add_literal(migraphx::literal{us, upd_vec});
+    auto scatternd =
+        mm->add_instruction(migraphx::make_op("scatternd_add"), data, indices, updates);
+    mm->add_return({scatternd});
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{8, 9, 10, 1, 1, 1, 6, 8, 10, 1, 1, 1};
+
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
+
+TEST_CASE(scatternd_add_transposed_data_test)
+{
+    migraphx::program p;
+    auto* mm   = p.get_main_module();
+    auto dtype = migraphx::shape::float_type;
+    auto itype = migraphx::shape::int64_type;
+    migraphx::shape ds{dtype, {3, 2}};
+    migraphx::shape is{itype, {2, 1}};
+    migraphx::shape us{dtype, {2, 3}};
+
+    std::vector<float> data_vec{1, 2, 3, 4, 5, 6};
+    std::vector<int64_t> ind_vec{1, 1};
+    std::vector<float> upd_vec{1, 1, 1, 10, 10, 10};
+
+    auto data = mm->add_literal(migraphx::literal{ds, data_vec});
+    auto tr = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), data);
+    auto indices = mm->add_literal(migraphx::literal{is, ind_vec});
+    auto updates = mm->add_literal(migraphx::literal{us, upd_vec});
+    auto scatternd = mm->add_instruction(migraphx::make_op("scatternd_add"), tr, indices, updates);
+    mm->add_return({scatternd});
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{1, 3, 5, 13, 15, 17};
+
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
+}
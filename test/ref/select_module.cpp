@@ -24,8 +24,10 @@
 #include <migraphx/instruction.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/op/select_module.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/select_module_statistics.hpp>
 #include <migraphx/verify.hpp>
 
 #include <test.hpp>
@@ -211,3 +213,59 @@ TEST_CASE(select_module_not_found_error)
     params["data"] = migraphx::argument(input_fixed_shape, input_data.data());
     EXPECT(test::throws([&] { std::ignore = p.eval(params).back(); }));
 }
+
+TEST_CASE(select_module_statistics_test)
+{
+    migraphx::program p;
+
+    // create batch submodules
+    auto create_submodule = [&](std::size_t batch_size, const std::string& module_name) {
+        auto* submod = p.create_module(module_name);
+        migraphx::shape sm_shape{migraphx::shape::float_type, {batch_size, 2, 2}};
+        auto sm_input = submod->add_parameter("data", sm_shape);
+        auto reduce_ins =
+            submod->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), sm_input);
+        auto squeeze_ins =
+            submod->add_instruction(migraphx::make_op("squeeze", {{"axes", {1}}}), reduce_ins);
+        submod->add_return({squeeze_ins});
+        return submod;
+    };
+    auto* batch1 = create_submodule(1, "batch_1");
+    auto* batch2 = create_submodule(2, "batch_2");
+
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {{1, 2}, {2, 2}, {2, 2}}};
+    auto input                              = mm->add_parameter("data", s);
+    std::vector<migraphx::shape> sub_shapes = {};
+    sub_shapes.push_back(migraphx::shape{migraphx::shape::float_type, {{1, 2}, {2, 2}}});
+    migraphx::shape out_attr = migraphx::shape{sub_shapes};
+    auto sm_ins              = mm->add_instruction(
+        migraphx::make_op("select_module", {{"output_dyn_shapes", migraphx::to_value(out_attr)}}),
+        {input},
+        {batch1, batch2});
+    auto ret = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), sm_ins);
+    mm->add_return({ret});
+    p.compile(migraphx::make_target("ref"));
+    EXPECT(migraphx::get_select_module_statistics(p).hits.empty());
+
+    auto run = [&](std::size_t batch) {
+        migraphx::parameter_map params;
+        migraphx::shape input_fixed_shape{migraphx::shape::float_type, {batch, 2, 2}};
+        std::vector<float> input_data(input_fixed_shape.elements(), 1);
+        params["data"] = migraphx::argument(input_fixed_shape, input_data.data());
+        p.eval(params);
+    };
+    run(2);
+    run(1);
+    run(2);
+
+    auto stats = migraphx::get_select_module_statistics(p);
+    EXPECT(stats.exact == 3);
+    EXPECT(stats.padded == 0);
+    EXPECT(stats.hits.at("batch_1") == 1);
+    EXPECT(stats.hits.at("batch_2") == 2);
+
+    // the runs are counted by each program
+    migraphx::program p2 = p;
+    EXPECT(migraphx::get_select_module_statistics(p2).hits.empty());
+}
@@ -168,3 +168,62 @@ TEST_CASE(softmax_dyn_test)
         0.42914796};
     EXPECT(migraphx::verify::verify_rms_range(results_vector, gold));
 }
+
+static std::vector<float> softmax_gold(const std::vector<float>& x, std::size_t n)
+{
+    std::vector<float> result(x.size());
+    for(std::size_t i = 0; i < x.size(); i += n)
+    {
+        double m = *std::max_element(x.begin() + i, x.begin() + i + n);
+        double s = 0;
+        for(std::size_t j = 0; j < n; j++)
+            s += std::exp(x[i + j] - m);
+        for(std::size_t j = 0; j < n; j++)
+            result[i + j] = std::exp(x[i + j] - m) / s;
+    }
+    return result;
+}
+
+TEST_CASE(softmax_long_row_test)
+{
+    // Rows span several blocks, with the maximum moving between blocks
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {3, 1000}};
+    std::vector<float> a(s.elements());
+    for(std::size_t i = 0; i < a.size(); i++)
+        a[i] = 500.0f + float((i * 37) % 101) * 0.25f;
+    auto al = mm->add_literal(migraphx::literal{s, a});
+    mm->add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), al);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, softmax_gold(a, 1000)));
+}
+
+TEST_CASE(softmax_transposed_test)
+{
+    // The softmax axis is strided in memory
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {70, 4}};
+    std::vector<float> a(s.elements());
+    for(std::size_t i = 0; i < a.size(); i++)
+        a[i] = float((i * 13) % 17) * 0.5f - 4.0f;
+    auto al = mm->add_literal(migraphx::literal{s, a});
+    auto tl = mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {1, 0}}}), al);
+    mm->add_instruction(migraphx::make_op("softmax", {{"axis", 1}}), tl);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+
+    std::vector<float> at(a.size());
+    for(std::size_t i = 0; i < 70; i++)
+    {
+        for(std::size_t j = 0; j < 4; j++)
+            at[j * 70 + i] = a[i * 4 + j];
+    }
+    EXPECT(migraphx::verify::verify_rms_range(results_vector, softmax_gold(at, 70)));
+}
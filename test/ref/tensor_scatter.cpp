@@ -0,0 +1,161 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/instruction.hpp>
+#include <migraphx/literal.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+
+#include <test.hpp>
+
+static std::vector<float> to_vector(const migraphx::argument& arg)
+{
+    std::vector<float> result;
+    arg.visit([&](auto output) { result.assign(output.begin(), output.end()); });
+    return result;
+}
+
+static migraphx::program make_kv_cache(const std::string& mode)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cs{migraphx::shape::float_type, {2, 3, 2}};
+    migraphx::shape us{migraphx::shape::float_type, {2, 1, 2}};
+    migraphx::shape is{migraphx::shape::int64_type, {2}};
+    auto cache   = mm->add_state("k", cs);
+    auto update  = mm->add_parameter("update", us);
+    auto indices = mm->add_parameter("indices", is);
+    auto r       = mm->add_instruction(
+        migraphx::make_op("tensor_scatter", {{"axis", 1}, {"mode", mode}}), cache, update, indices);
+    mm->add_return({r});
+    p.compile(migraphx::make_target("ref"));
+    return p;
+}
+
+static migraphx::argument
+step(const migraphx::program& p, std::vector<float> update, std::vector<int64_t> indices)
+{
+    migraphx::shape us{migraphx::shape::float_type, {2, 1, 2}};
+    migraphx::shape is{migraphx::shape::int64_type, {2}};
+    return p
+        .eval({{"update", migraphx::argument{us, update.data()}},
+               {"indices", migraphx::argument{is, indices.data()}}})
+        .back();
+}
+
+TEST_CASE(tensor_scatter_state_test)
+{
+    auto p = make_kv_cache("linear");
+    step(p, {1, 2, 3, 4}, {0, 1});
+    auto result = step(p, {5, 6, 7, 8}, {1, 2});
+    std::vector<float> gold = {1, 2, 5, 6, 0, 0, 0, 0, 3, 4, 7, 8};
+    EXPECT(to_vector(result) == gold);
+    EXPECT(to_vector(p.get_state("k")) == gold);
+}
+
+TEST_CASE(tensor_scatter_reset_test)
+{
+    auto p = make_kv_cache("linear");
+    step(p, {1, 2, 3, 4}, {0, 0});
+    p.reset_state();
+    EXPECT(to_vector(p.get_state("k")) == std::vector<float>(12, 0));
+    auto result = step(p, {5, 6, 7, 8}, {2, 2});
+    EXPECT(to_vector(result) == std::vector<float>{0, 0, 0, 0, 5, 6, 0, 0, 0, 0, 7, 8});
+}
+
+TEST_CASE(tensor_scatter_copy_test)
+{
+    auto p1 = make_kv_cache("linear");
+    step(p1, {1, 2, 3, 4}, {0, 0});
+    auto p2 = p1;
+    step(p2, {5, 6, 7, 8}, {1, 1});
+    EXPECT(to_vector(p1.get_state("k")) ==
+           std::vector<float>{1, 2, 0, 0, 0, 0, 3, 4, 0, 0, 0, 0});
+    EXPECT(to_vector(p2.get_state("k")) ==
+           std::vector<float>{0, 0, 5, 6, 0, 0, 0, 0, 7, 8, 0, 0});
+}
+
+TEST_CASE(tensor_scatter_circular_test)
+{
+    auto p      = make_kv_cache("circular");
+    auto result = step(p, {1, 2, 3, 4}, {3, 5});
+    EXPECT(to_vector(result) == std::vector<float>{1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 3, 4});
+}
+
+TEST_CASE(tensor_scatter_out_of_bounds_test)
+{
+    auto p = make_kv_cache("linear");
+    EXPECT(test::throws([&] { step(p, {1, 2, 3, 4}, {0, 3}); }));
+}
+
+TEST_CASE(tensor_scatter_non_std_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cs{migraphx::shape::float_type, {1, 4, 3}};
+    migraphx::shape us{migraphx::shape::float_type, {1, 3, 2}};
+    auto cache  = mm->add_literal(migraphx::literal{cs, std::vector<float>(12, 0)});
+    auto update = mm->add_literal(migraphx::literal{us, {1, 2, 3, 4, 5, 6}});
+    auto tupdate =
+        mm->add_instruction(migraphx::make_op("transpose", {{"permutation", {0, 2, 1}}}), update);
+    mm->add_instruction(migraphx::make_op("tensor_scatter"), cache, tupdate);
+    p.compile(migraphx::make_target("ref"));
+    auto result = p.eval({}).back();
+    EXPECT(to_vector(result) == std::vector<float>{1, 3, 5, 2, 4, 6, 0, 0, 0, 0, 0, 0});
+}
+
+TEST_CASE(tensor_scatter_param_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cs{migraphx::shape::float_type, {1, 3, 2}};
+    migraphx::shape us{migraphx::shape::float_type, {1, 1, 2}};
+    auto cache  = mm->add_parameter("cache", cs);
+    auto update = mm->add_parameter("update", us);
+    mm->add_instruction(migraphx::make_op("tensor_scatter", {{"axis", 1}}), cache, update);
+    p.compile(migraphx::make_target("ref"));
+    std::vector<float> cache_data(6, 0);
+    std::vector<float> update_data = {1, 2};
+    auto result = p.eval({{"cache", migraphx::argument{cs, cache_data.data()}},
+                          {"update", migraphx::argument{us, update_data.data()}}})
+                      .back();
+    EXPECT(to_vector(result) == std::vector<float>{1, 2, 0, 0, 0, 0});
+    EXPECT(cache_data == std::vector<float>(6, 0));
+}
+
+TEST_CASE(tensor_scatter_unused_state_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cs{migraphx::shape::float_type, {1, 3, 2}};
+    migraphx::shape us{migraphx::shape::float_type, {1, 1, 2}};
+    auto cache  = mm->add_state("k", cs);
+    auto update = mm->add_parameter("update", us);
+    mm->add_instruction(migraphx::make_op("tensor_scatter", {{"axis", 1}}), cache, update);
+    mm->add_return({mm->add_instruction(migraphx::make_op("neg"), update)});
+    p.compile(migraphx::make_target("ref"));
+    std::vector<float> update_data = {1, 2};
+    p.eval({{"update", migraphx::argument{us, update_data.data()}}});
+    EXPECT(to_vector(p.get_state("k")) == std::vector<float>{1, 2, 0, 0, 0, 0});
+}
@@ -81,3 +81,73 @@ TEST_CASE(topk_test)
         EXPECT(results.second == gold_ind);
     }
 }
+
+using topk_result = std::pair<std::vector<float>, std::vector<int64_t>>;
+
+static topk_result run_topk(const std::vector<float>& data,
+                            std::size_t rows,
+                            std::size_t cols,
+                            int64_t k,
+                            bool largest)
+{
+    // Select along axis 0 so the elements of a slice are strided
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {rows, cols}};
+    auto l = mm->add_literal(migraphx::literal{s, data});
+    auto r = mm->add_instruction(
+        migraphx::make_op("topk", {{"axis", 0}, {"k", k}, {"largest", largest}}), l);
+    auto r0 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), r);
+    auto r1 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), r);
+    mm->add_return({r0, r1});
+    p.compile(migraphx::make_target("ref"));
+    auto rets = p.eval({});
+    std::vector<float> ret_val;
+    rets.front().visit([&](auto v) { ret_val.assign(v.begin(), v.end()); });
+    std::vector<int64_t> ret_ind;
+    rets.back().visit([&](auto v) { ret_ind.assign(v.begin(), v.end()); });
+    return std::make_pair(ret_val, ret_ind);
+}
+
+static topk_result topk_gold(const std::vector<float>& data,
+                             std::size_t rows,
+                             std::size_t cols,
+                             int64_t k,
+                             bool largest)
+{
+    std::vector<float> gold_val(k * cols);
+    std::vector<int64_t> gold_ind(k * cols);
+    for(std::size_t c = 0; c < cols; c++)
+    {
+        std::vector<int64_t> ind(rows);
+        std::iota(ind.begin(), ind.end(), 0);
+        // Ties keep the lower index first
+        std::stable_sort(ind.begin(), ind.end(), [&](auto x, auto y) {
+            return largest ? data[x * cols + c] > data[y * cols + c]
+                           : data[x * cols + c] < data[y * cols + c];
+        });
+        for(int64_t j = 0; j < k; j++)
+        {
+            gold_val[j * cols + c] = data[ind[j] * cols + c];
+            gold_ind[j * cols + c] = ind[j];
+        }
+    }
+    return std::make_pair(gold_val, gold_ind);
+}
+
+TEST_CASE(topk_ties_test)
+{
+    std::vector<float> data(1000 * 3);
+    for(std::size_t i = 0; i < data.size(); i++)
+        data[i] = float((i * 7919) % 61);
+    for(int64_t k : {1, 5, 16, 17, 200, 1000})
+    {
+        for(bool largest : {true, false})
+        {
+            auto results = run_topk(data, 1000, 3, k, largest);
+            auto gold    = topk_gold(data, 1000, 3, k, largest);
+            EXPECT(results.first == gold.first);
+            EXPECT(results.second == gold.second);
+        }
+    }
+}
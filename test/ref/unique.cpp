@@ -27,6 +27,8 @@
 #include <migraphx/onnx.hpp>
 #include <migraphx/register_target.hpp>
 #include <migraphx/verify.hpp>
+#include <algorithm>
+#include <numeric>
 #include <optional>
 #include <test.hpp>
 
@@ -340,3 +342,71 @@ TEST_CASE(unique_subtensors_zero_axis_test)
     std::vector<int64_t> gold_ct = {2};
     EXPECT(ct == gold_ct);
 }
+
+TEST_CASE(unique_large_hashed_test)
+{
+    // Many duplicates of values with the same low bits, including -0.0 and 0.0
+    std::vector<float> data(20000);
+    for(std::size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<float>((i * 7919) % 613) * 1024.0f;
+    data[5]  = -0.0f;
+    data[17] = 0.0f;
+    migraphx::shape data_shape{migraphx::shape::float_type, {data.size()}};
+
+    for(int sorted : {0, 1})
+    {
+        auto [y, y_idx, x_rev_idx, y_ct] = run_program(data, data_shape, sorted);
+
+        std::vector<float> gold_y;
+        std::vector<int64_t> gold_y_idx;
+        for(std::size_t i = 0; i < data.size(); i++)
+        {
+            if(std::find(gold_y.begin(), gold_y.end(), data[i]) != gold_y.end())
+                continue;
+            gold_y.push_back(data[i]);
+            gold_y_idx.push_back(i);
+        }
+        if(sorted == 1)
+        {
+            std::vector<std::size_t> order(gold_y.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](auto a, auto b) {
+                return gold_y[a] < gold_y[b];
+            });
+            std::vector<float> sorted_y;
+            std::vector<int64_t> sorted_y_idx;
+            for(auto i : order)
+            {
+                sorted_y.push_back(gold_y[i]);
+                sorted_y_idx.push_back(gold_y_idx[i]);
+            }
+            gold_y     = sorted_y;
+            gold_y_idx = sorted_y_idx;
+        }
+        EXPECT(y.size() == 613);
+        EXPECT(y == gold_y);
+        EXPECT(y_idx == gold_y_idx);
+        std::vector<int64_t> gold_y_ct(y.size(), 0);
+        for(std::size_t i = 0; i < data.size(); i++)
+        {
+            EXPECT(y[x_rev_idx[i]] == data[i]);
+            gold_y_ct[x_rev_idx[i]]++;
+        }
+        EXPECT(y_ct == gold_y_ct);
+    }
+}
+
+TEST_CASE(unique_subtensors_empty_test)
+{
+    // The chunks along the axis are empty, so there is nothing to hash
+    std::vector<float> data;
+    migraphx::shape data_shape{migraphx::shape::float_type, {3, 0}};
+    for(int sorted : {0, 1})
+    {
+        const auto& [y, idx, x_rev, ct] = run_program(data, data_shape, sorted, 0);
+        EXPECT(y.empty());
+        EXPECT(idx.empty());
+        EXPECT(x_rev.empty());
+        EXPECT(ct.empty());
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/rewrite_resize.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/verify.hpp>
+#include <test.hpp>
+
+static void opt_resize(migraphx::module& m)
+{
+    migraphx::rewrite_resize rr;
+    migraphx::dead_code_elimination dce;
+    rr.apply(m);
+    dce.apply(m);
+}
+
+static bool has_resize(const migraphx::module& m)
+{
+    return std::any_of(m.begin(), m.end(), [](const auto& ins) { return ins.name() == "resize"; });
+}
+
+static migraphx::program make_resize_program(const migraphx::shape& s, const migraphx::value& v)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", s);
+    mm->add_instruction(migraphx::make_op("resize", v), x);
+    return p;
+}
+
+static void check_rewrite(const migraphx::shape& s, const migraphx::value& v)
+{
+    auto p1 = make_resize_program(s, v);
+    auto p2 = p1;
+    opt_resize(*p2.get_main_module());
+    EXPECT(not has_resize(*p2.get_main_module()));
+
+    p1.compile(migraphx::make_target("ref"));
+    p2.compile(migraphx::make_target("ref"));
+    migraphx::parameter_map params;
+    params["x"]  = migraphx::generate_argument(s);
+    auto result1 = p1.eval(params).back();
+    auto result2 = p2.eval(params).back();
+    EXPECT(result1.get_shape() == result2.get_shape());
+    std::vector<float> results1;
+    std::vector<float> results2;
+    result1.visit([&](auto output) { results1.assign(output.begin(), output.end()); });
+    result2.visit([&](auto output) { results2.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify::verify_rms_range(results1, results2));
+}
+
+TEST_CASE(rewrite_resize_linear)
+{
+    check_rewrite({migraphx::shape::float_type, {1, 2, 3, 4}},
+                  {{"scales", {1.0f, 1.0f, 2.0f, 1.5f}},
+                   {"mode", "linear"},
+                   {"coordinate_transformation_mode", "half_pixel"}});
+}
+
+TEST_CASE(rewrite_resize_linear_downsample)
+{
+    check_rewrite({migraphx::shape::float_type, {2, 1, 6, 5}},
+                  {{"sizes", {2, 1, 4, 2}},
+                   {"mode", "linear"},
+                   {"coordinate_transformation_mode", "align_corners"}});
+}
+
+TEST_CASE(rewrite_resize_cubic)
+{
+    check_rewrite({migraphx::shape::float_type, {1, 1, 5, 5}},
+                  {{"sizes", {1, 1, 7, 3}},
+                   {"mode", "cubic"},
+                   {"exclude_outside", true},
+                   {"coordinate_transformation_mode", "pytorch_half_pixel"}});
+}
+
+TEST_CASE(rewrite_resize_nearest)
+{
+    auto p = make_resize_program({migraphx::shape::float_type, {1, 1, 2, 2}},
+                                 {{"scales", {1.0f, 1.0f, 2.0f, 2.0f}}, {"mode", "nearest"}});
+    opt_resize(*p.get_main_module());
+    EXPECT(has_resize(*p.get_main_module()));
+}
+
+TEST_CASE(rewrite_resize_integral)
+{
+    auto p = make_resize_program({migraphx::shape::int32_type, {1, 1, 2, 2}},
+                                 {{"scales", {1.0f, 1.0f, 2.0f, 2.0f}}, {"mode", "linear"}});
+    opt_resize(*p.get_main_module());
+    EXPECT(has_resize(*p.get_main_module()));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -175,6 +175,45 @@ TEST_CASE(resize_scales)
     EXPECT(m0 == m1);
 }
 
+TEST_CASE(resize_linear)
+{
+    migraphx::module m0;
+    {
+        std::vector<float> ds = {1., 1., 2., 3.};
+        migraphx::shape ss{migraphx::shape::float_type, {4}};
+
+        auto li = m0.add_literal(migraphx::literal{ss, ds});
+        m0.add_instruction(migraphx::make_op("undefined"));
+
+        migraphx::shape sx{migraphx::shape::float_type, {1, 1, 2, 2}};
+        auto inx = m0.add_parameter("X", sx);
+
+        auto r = m0.add_instruction(
+            migraphx::make_op("resize",
+                              {{"mode", "linear"}, {"coordinate_transformation_mode", "half_pixel"}}),
+            inx,
+            li);
+
+        m0.add_return({r});
+    }
+    run_pass(m0);
+
+    migraphx::module m1;
+    {
+        migraphx::shape sx{migraphx::shape::float_type, {1, 1, 2, 2}};
+        auto inx = m1.add_parameter("X", sx);
+
+        auto r = m1.add_instruction(migraphx::make_op("resize",
+                                                      {{"mode", "linear"},
+                                                       {"scales", {1., 1., 2., 3.}},
+                                                       {"coordinate_transformation_mode",
+                                                        "half_pixel"}}),
+                                    inx);
+        m1.add_return({r});
+    }
+    EXPECT(m0 == m1);
+}
+
 TEST_CASE(static_broadcast)
 {
     migraphx::module m0;
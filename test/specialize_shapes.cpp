@@ -0,0 +1,193 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <migraphx/specialize_shapes.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/marker.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/register_target.hpp>
+#include <numeric>
+#include <sstream>
+#include "test.hpp"
+
+static migraphx::program make_dynamic_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {{1, 4, {2, 4}}, {3, 3}}};
+    auto x  = mm->add_parameter("x", s);
+    auto y  = mm->add_parameter("y", {migraphx::shape::float_type, {3}});
+    auto by = mm->add_instruction(migraphx::make_op("multibroadcast"), y, x);
+    mm->add_instruction(migraphx::make_op("add"), x, by);
+    return p;
+}
+
+static migraphx::program compile_specialized(std::size_t size, bool precompile = false)
+{
+    auto p = make_dynamic_program();
+    migraphx::compile_options options;
+    options.specialize_cache_size = size;
+    options.precompile_optimals   = precompile;
+    p.compile(migraphx::make_target("ref"), options);
+    return p;
+}
+
+static migraphx::parameter_map make_params(std::size_t batch)
+{
+    static std::vector<float> x(4 * 3);
+    static std::vector<float> y = {10, 20, 30};
+    std::iota(x.begin(), x.end(), 0);
+    migraphx::parameter_map params;
+    params["x"] = migraphx::argument{{migraphx::shape::float_type, {batch, 3}}, x.data()};
+    params["y"] = migraphx::argument{{migraphx::shape::float_type, {3}}, y.data()};
+    return params;
+}
+
+static std::vector<float> run(const migraphx::program& p, std::size_t batch)
+{
+    auto result = p.eval(make_params(batch)).back();
+    EXPECT(result.get_shape() == migraphx::shape{migraphx::shape::float_type, {batch, 3}});
+    std::vector<float> output;
+    result.visit([&](auto r) { output.assign(r.begin(), r.end()); });
+    return output;
+}
+
+static std::vector<float> gold(std::size_t batch)
+{
+    std::vector<float> result(batch * 3);
+    std::iota(result.begin(), result.end(), 0);
+    for(std::size_t i = 0; i < result.size(); i++)
+        result[i] += 10 * (i % 3 + 1);
+    return result;
+}
+
+TEST_CASE(specialize_shapes_static)
+{
+    auto p   = make_dynamic_program();
+    auto sp  = migraphx::specialize_shapes(p, {{"x", {migraphx::shape::float_type, {2, 3}}}});
+    auto* mm = sp.get_main_module();
+    EXPECT(mm->get_parameter_names() == p.get_main_module()->get_parameter_names());
+    EXPECT(mm->get_parameter_shape("x") == migraphx::shape{migraphx::shape::float_type, {2, 3}});
+    EXPECT(sp.get_output_shapes().front() ==
+           migraphx::shape{migraphx::shape::float_type, {2, 3}});
+    // The original program is not changed
+    EXPECT(p.get_main_module()->get_parameter_shape("x").dynamic());
+}
+
+TEST_CASE(specialization_cache_eval)
+{
+    auto p = compile_specialized(2);
+    EXPECT(p.is_compiled());
+    for(std::size_t batch : {2, 3, 2, 4, 2})
+        EXPECT(run(p, batch) == gold(batch));
+    auto stats = p.get_specialization_cache()->get_statistics();
+    EXPECT(stats.hits == 2);
+    EXPECT(stats.misses == 3);
+    EXPECT(stats.size == 2);
+}
+
+TEST_CASE(specialization_cache_lru)
+{
+    auto p = compile_specialized(2);
+    for(std::size_t batch : {1, 2, 3, 1})
+        EXPECT(run(p, batch) == gold(batch));
+    // Batch 1 was dropped when batch 3 was compiled
+    auto stats = p.get_specialization_cache()->get_statistics();
+    EXPECT(stats.hits == 0);
+    EXPECT(stats.misses == 4);
+}
+
+TEST_CASE(specialization_cache_precompile)
+{
+    auto p      = compile_specialized(4, true);
+    auto* cache = p.get_specialization_cache().get();
+    cache->wait();
+    EXPECT(cache->get_statistics().precompiled == 2);
+    EXPECT(run(p, 4) == gold(4));
+    EXPECT(run(p, 2) == gold(2));
+    EXPECT(cache->get_statistics().hits == 2);
+    EXPECT(cache->get_statistics().misses == 0);
+}
+
+TEST_CASE(specialization_cache_bad_shape)
+{
+    auto p = compile_specialized(2);
+    EXPECT(test::throws([&] { run(p, 5); }));
+    EXPECT(test::throws([&] { p.eval({}); }));
+}
+
+TEST_CASE(specialization_cache_static_program)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {2, 3}});
+    mm->add_instruction(migraphx::make_op("relu"), x);
+    migraphx::compile_options options;
+    options.specialize_cache_size = 2;
+    p.compile(migraphx::make_target("ref"), options);
+    EXPECT(p.get_specialization_cache() == nullptr);
+}
+
+struct count_marker
+{
+    std::shared_ptr<std::size_t> instructions = std::make_shared<std::size_t>(0);
+
+    void mark_start(migraphx::instruction_ref) { (*instructions)++; }
+    void mark_stop(migraphx::instruction_ref) {}
+    void mark_start(const migraphx::program& p) { EXPECT(not p.get_specialization_cache()); }
+    void mark_stop(const migraphx::program&) {}
+};
+
+TEST_CASE(specialization_cache_other_evals)
+{
+    auto p      = compile_specialized(2);
+    auto params = make_params(3);
+    std::vector<migraphx::context> ctx{p.get_context()};
+    auto result = p.eval_with_context(ctx, params).back();
+    EXPECT(result.get_shape() == migraphx::shape{migraphx::shape::float_type, {3, 3}});
+    p.dry_run(params);
+    count_marker m;
+    p.mark(params, m);
+    EXPECT(*m.instructions > 0);
+    std::stringstream ss;
+    p.perf_report(ss, 1, params);
+    EXPECT(migraphx::contains(ss.str(), "Summary:"));
+    EXPECT(test::throws([&] { p.time_instructions(1, params); }));
+    auto stats = p.get_specialization_cache()->get_statistics();
+    EXPECT(stats.misses == 1);
+    EXPECT(stats.size == 1);
+}
+
+TEST_CASE(specialization_cache_state)
+{
+    auto p = make_dynamic_program();
+    p.get_main_module()->add_state("s", {migraphx::shape::float_type, {3}});
+    migraphx::compile_options options;
+    options.specialize_cache_size = 2;
+    EXPECT(test::throws([&] { p.compile(migraphx::make_target("ref"), options); }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -23,14 +23,19 @@
  */
 
 #include <migraphx/split_single_dyn_dim.hpp>
+#include <migraphx/simplify_dyn_ops.hpp>
+#include <migraphx/select_module_statistics.hpp>
+#include <migraphx/register_target.hpp>
 #include <migraphx/program.hpp>
 #include <migraphx/dead_code_elimination.hpp>
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/op/select_module.hpp>
 #include <migraphx/serialize.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/instruction_ref.hpp>
 #include <migraphx/builtin.hpp>
+#include <numeric>
 #include <test.hpp>
 
 // Forward declare any_cast
@@ -327,4 +332,94 @@ TEST_CASE(ordered_inputs_to_select_module)
     EXPECT(std::is_sorted(sm_param_names.begin(), sm_param_names.end()));
 }
 
+TEST_CASE(bucketing_optimals)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {{1, 8, {2, 4}}, {4, 4}}};
+    auto input = mm->add_parameter("data", s);
+    migraphx::shape lit_s{migraphx::shape{migraphx::shape::float_type, {1}}};
+    auto literal_ins = mm->add_literal(migraphx::literal{lit_s, {6}});
+    auto broadcast_lit =
+        mm->add_instruction(migraphx::make_op("multibroadcast"), literal_ins, input);
+    auto add_ins = mm->add_instruction(migraphx::make_op("add"), input, broadcast_lit);
+    mm->add_return({add_ins});
+    migraphx::run_passes(
+        p, {migraphx::split_single_dyn_dim{true, 1}, migraphx::dead_code_elimination{}});
+
+    auto sm_ins = std::find_if(
+        mm->begin(), mm->end(), [&](auto&& ins) { return ins.name() == "select_module"; });
+    EXPECT(bool{sm_ins != mm->end()});
+    std::vector<std::string> names;
+    std::transform(sm_ins->module_inputs().begin(),
+                   sm_ins->module_inputs().end(),
+                   std::back_inserter(names),
+                   [](auto* m) { return m->name(); });
+    EXPECT(names == std::vector<std::string>{
+                        "dim_1", "dim_2", "dim_3", "dim_4", "dim_5", "dim_6", "dim_7", "dim_8"});
+
+    // the sizes in between pad their inputs up to the next optimal and slice the outputs back
+    const auto* dim_3 = p.get_module("dim_3");
+    migraphx::module expected;
+    {
+        migraphx::shape out_s{migraphx::shape::float_type, {4, 4}};
+        migraphx::shape bucket_shapes{std::vector<migraphx::shape>{out_s}};
+        auto x   = expected.add_parameter("data", {migraphx::shape::float_type, {3, 4}});
+        auto pad = expected.add_instruction(
+            migraphx::make_op("pad", {{"pads", {0, 0, 1, 0}}, {"value", 1}}), x);
+        auto bucket = expected.add_instruction(migraphx::op::select_module{bucket_shapes},
+                                               {pad},
+                                               {p.get_module("dim_4")});
+        auto elem =
+            expected.add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), bucket);
+        auto slice = expected.add_instruction(
+            migraphx::make_op("slice", {{"axes", {0}}, {"starts", {0}}, {"ends", {3}}}), elem);
+        expected.add_return({slice});
+    }
+    EXPECT(*dim_3 == expected);
+}
+
+TEST_CASE(bucketing_eval)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {{1, 4, {2}}, {3, 3}}};
+    auto input = mm->add_parameter("data", s);
+    auto reduce_ins  = mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), input);
+    auto squeeze_ins =
+        mm->add_instruction(migraphx::make_op("squeeze", {{"axes", {1}}}), reduce_ins);
+    mm->add_return({squeeze_ins});
+    migraphx::run_passes(p,
+                         {migraphx::split_single_dyn_dim{true, -1},
+                          migraphx::dead_code_elimination{},
+                          migraphx::simplify_dyn_ops{},
+                          migraphx::dead_code_elimination{}});
+    p.compile(migraphx::make_target("ref"));
+
+    for(std::size_t batch : {1, 2, 3, 4, 3})
+    {
+        migraphx::shape batch_shape{migraphx::shape::float_type, {batch, 3}};
+        std::vector<float> data(batch_shape.elements());
+        std::iota(data.begin(), data.end(), 0);
+        migraphx::parameter_map params;
+        params["data"] = migraphx::argument(batch_shape, data.data());
+        auto result    = p.eval(params).back();
+        EXPECT(result.get_shape().lens() == std::vector<std::size_t>{batch});
+        std::vector<float> results_vector;
+        result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+        std::vector<float> gold;
+        for(std::size_t i = 0; i < batch; i++)
+            gold.push_back(9 * i + 3);
+        EXPECT(results_vector == gold);
+    }
+
+    auto stats = migraphx::get_select_module_statistics(p);
+    EXPECT(stats.exact == 2);
+    EXPECT(stats.padded == 3);
+    EXPECT(stats.hits.at("dim_1") == 1);
+    EXPECT(stats.hits.at("dim_2") == 1);
+    EXPECT(stats.hits.at("dim_3") == 2);
+    EXPECT(stats.hits.at("dim_4") == 1);
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
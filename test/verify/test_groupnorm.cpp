@@ -0,0 +1,97 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <numeric>
+
+migraphx::instruction_ref add_groupnorm(migraphx::module& m,
+                                        migraphx::instruction_ref x,
+                                        std::size_t groups,
+                                        float eps = 1e-5f)
+{
+    auto mgx_type   = x->get_shape().type();
+    auto x_lens     = x->get_shape().lens();
+    auto channels   = x_lens.at(1);
+    auto group_lens = x_lens;
+
+    group_lens.at(1) = channels / groups;
+    group_lens.insert(group_lens.begin() + 1, groups);
+    std::vector<std::size_t> axes(group_lens.size() - 2);
+    std::iota(axes.begin(), axes.end(), 2);
+    auto scale   = m.add_parameter("scale", migraphx::shape{mgx_type, {channels}});
+    auto bias    = m.add_parameter("bias", migraphx::shape{mgx_type, {channels}});
+    auto epsilon = m.add_literal(migraphx::literal{migraphx::shape{mgx_type}, {eps}});
+
+    auto xg   = m.add_instruction(migraphx::make_op("reshape", {{"dims", group_lens}}), x);
+    auto mean = m.add_instruction(migraphx::make_op("reduce_mean", {{"axes", axes}}), xg);
+    auto mean_mbcast =
+        m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", group_lens}}), mean);
+    auto sub = m.add_instruction(migraphx::make_op("sub"), xg, mean_mbcast);
+    auto sq  = m.add_instruction(migraphx::make_op("mul"), sub, sub);
+    auto var = m.add_instruction(migraphx::make_op("reduce_mean", {{"axes", axes}}), sq);
+    auto epsilon_mbcast = m.add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", var->get_shape().lens()}}), epsilon);
+    auto add_epsilon = m.add_instruction(migraphx::make_op("add"), var, epsilon_mbcast);
+    auto rsqrt       = m.add_instruction(migraphx::make_op("rsqrt"), add_epsilon);
+    auto rsqrt_mbcast =
+        m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", group_lens}}), rsqrt);
+    auto norm = m.add_instruction(migraphx::make_op("mul"), sub, rsqrt_mbcast);
+    auto y    = m.add_instruction(migraphx::make_op("reshape", {{"dims", x_lens}}), norm);
+    auto scale_bcast = m.add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", x_lens}}), scale);
+    auto mul = m.add_instruction(migraphx::make_op("mul"), y, scale_bcast);
+    auto bias_bcast = m.add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"out_lens", x_lens}}), bias);
+    return m.add_instruction(migraphx::make_op("add"), mul, bias_bcast);
+}
+
+struct test_groupnorm : verify_program<test_groupnorm>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {2, 32, 8, 8}};
+        auto x = mm->add_parameter("x", s);
+        add_groupnorm(*mm, x, 4);
+        return p;
+    }
+};
+
+struct test_groupnorm_large : verify_program<test_groupnorm_large>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {1, 64, 32, 32}};
+        auto x = mm->add_parameter("x", s);
+        add_groupnorm(*mm, x, 2);
+        return p;
+    }
+};
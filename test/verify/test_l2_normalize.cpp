@@ -0,0 +1,74 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+migraphx::instruction_ref
+add_l2_normalize(migraphx::module& m, migraphx::instruction_ref x, float eps = 1e-12f)
+{
+    auto mgx_type = x->get_shape().type();
+    auto x_lens   = x->get_shape().lens();
+    auto axis     = x_lens.size() - 1;
+    auto epsilon  = m.add_literal(migraphx::literal{migraphx::shape{mgx_type}, {eps}});
+
+    auto sq  = m.add_instruction(migraphx::make_op("mul"), x, x);
+    auto sum = m.add_instruction(migraphx::make_op("reduce_sum", {{"axes", {axis}}}), sq);
+    auto epsilon_mbcast = m.add_instruction(
+        migraphx::make_op("multibroadcast", {{"out_lens", sum->get_shape().lens()}}), epsilon);
+    auto add_epsilon = m.add_instruction(migraphx::make_op("add"), sum, epsilon_mbcast);
+    auto norm        = m.add_instruction(migraphx::make_op("sqrt"), add_epsilon);
+    auto norm_mbcast =
+        m.add_instruction(migraphx::make_op("multibroadcast", {{"out_lens", x_lens}}), norm);
+    return m.add_instruction(migraphx::make_op("div"), x, norm_mbcast);
+}
+
+struct test_l2_normalize : verify_program<test_l2_normalize>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {2, 16, 128}};
+        auto x = mm->add_parameter("x", s);
+        add_l2_normalize(*mm, x);
+        return p;
+    }
+};
+
+struct test_l2_normalize_large : verify_program<test_l2_normalize_large>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {4, 65536}};
+        auto x = mm->add_parameter("x", s);
+        add_l2_normalize(*mm, x);
+        return p;
+    }
+};